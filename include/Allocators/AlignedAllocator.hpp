@@ -0,0 +1,268 @@
+#ifndef ALLOCATORS_ALIGNED_ALLOCATOR_HPP
+#define ALLOCATORS_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "Allocators/Allocator.hpp"
+#include "Parallel/CacheLine.hpp"
+
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Same as DynamicAllocator but the buffer starts on an alignment boundary (cache line by default),
+// so simd loads from the beginning of the data never split a line
+template<typename T, size_t alignment = cacheLineSize>
+class AlignedAllocator final : public IAllocator<T>
+{
+    static_assert((alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+    static_assert(alignment >= alignof(T), "alignment can't be weaker than type alignment");
+
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+
+public:
+    AlignedAllocator() noexcept : data_(nullptr), size_(0), capacity_(0) {}
+    AlignedAllocator(size_t size);
+    AlignedAllocator(size_t size, const T& value);
+    AlignedAllocator(const AlignedAllocator& other);
+
+    AlignedAllocator& operator=(const AlignedAllocator& other);
+
+    T* data() noexcept override;
+
+    const T* data()   const noexcept override;
+    size_t size()     const noexcept override;
+    size_t capacity() const noexcept override;
+
+    void size(const size_t newSize) noexcept override;
+
+    void free() noexcept override;
+    void realloc(size_t newCapacity) override;
+    void realloc(size_t newCapacity, const T& value) override;
+
+    // Never throws, elements must be nothrow copy constructible
+    StdErrors tryRealloc(size_t newCapacity) noexcept;
+
+    void dtorElements(size_t from, size_t to) noexcept override;
+
+    AllocatorProxyValue<T> operator[](size_t pos) override;
+    const T& operator[](size_t pos) const override;
+
+    void swap(AlignedAllocator& other) noexcept;
+
+    ~AlignedAllocator();
+
+private:
+    static T* allocateAligned(size_t capacity);
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, size_t alignment>
+T* AlignedAllocator<T, alignment>::allocateAligned(size_t capacity)
+{
+    if (capacity == 0)
+        return nullptr;
+
+    EXCEPTIONS_TRY
+    {
+        return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignment)));
+    }
+    EXCEPTIONS_CATCH(std::bad_alloc&)
+    {
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::MemAllocErr,
+            "Failed to allocate memory in aligned allocator",
+            {}
+        );
+    }
+}
+
+template<typename T, size_t alignment>
+void AlignedAllocator<T, alignment>::swap(AlignedAllocator& other) noexcept
+{
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template<typename T, size_t alignment>
+AlignedAllocator<T, alignment>::AlignedAllocator(size_t size) :
+    data_(allocateAligned(size)), size_(0), capacity_(size)
+{
+}
+
+template<typename T, size_t alignment>
+AlignedAllocator<T, alignment>::AlignedAllocator(size_t size, const T& value) : AlignedAllocator(size)
+{
+    EXCEPTIONS_TRY
+    {
+        copyData(*this, 0, capacity_, value);
+    }
+    EXCEPTIONS_CATCH_WITH_REASON(e)
+    {
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::AllocatorCtorErr,
+            "Can't copy into allocated memory in aligned allocator",
+            std::move(e)
+        );
+    }
+}
+
+template<typename T, size_t alignment>
+AlignedAllocator<T, alignment>::AlignedAllocator(const AlignedAllocator& other) : AlignedAllocator(other.capacity_)
+{
+    EXCEPTIONS_TRY
+    {
+        copyData(*this, 0, other.data_, other.size_);
+    }
+    EXCEPTIONS_CATCH_WITH_REASON(e)
+    {
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::AllocatorCtorErr,
+            "Can't copy into allocated memory in aligned allocator",
+            std::move(e)
+        );
+    }
+}
+
+template<typename T, size_t alignment>
+AlignedAllocator<T, alignment>& AlignedAllocator<T, alignment>::operator=(const AlignedAllocator& other)
+{
+    AlignedAllocator tmp{other};
+    swap(tmp);
+
+    return *this;
+}
+
+template<typename T, size_t alignment>
+T* AlignedAllocator<T, alignment>::data() noexcept
+{
+    return data_;
+}
+
+template<typename T, size_t alignment>
+const T* AlignedAllocator<T, alignment>::data() const noexcept
+{
+    return data_;
+}
+
+template<typename T, size_t alignment>
+size_t AlignedAllocator<T, alignment>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, size_t alignment>
+size_t AlignedAllocator<T, alignment>::capacity() const noexcept
+{
+    return capacity_;
+}
+
+template<typename T, size_t alignment>
+void AlignedAllocator<T, alignment>::size(const size_t newSize) noexcept
+{
+    size_ = newSize;
+}
+
+template<typename T, size_t alignment>
+void AlignedAllocator<T, alignment>::free() noexcept
+{
+    dtorElements(0, size_);
+
+    if (data_)
+        ::operator delete(data_, std::align_val_t(alignment));
+
+    data_     = nullptr;
+    capacity_ = 0;
+}
+
+template<typename T, size_t alignment>
+void AlignedAllocator<T, alignment>::realloc(size_t newCapacity)
+{
+    AlignedAllocator tmp{newCapacity};
+
+    copyData(tmp, 0, data_, std::min(size_, newCapacity));
+
+    swap(tmp);
+}
+
+template<typename T, size_t alignment>
+void AlignedAllocator<T, alignment>::realloc(size_t newCapacity, const T& value)
+{
+    AlignedAllocator tmp{newCapacity, value};
+
+    copyData(tmp, 0, data_, std::min(size_, newCapacity));
+
+    swap(tmp);
+}
+
+template<typename T, size_t alignment>
+StdErrors AlignedAllocator<T, alignment>::tryRealloc(size_t newCapacity) noexcept
+{
+    static_assert(std::is_nothrow_copy_constructible<T>::value, "tryRealloc can't copy elements that may throw");
+
+    if (newCapacity > static_cast<size_t>(-1) / sizeof(T))
+        return StdErrors::MemAllocErr;
+
+    T* newData = nullptr;
+
+    if (newCapacity != 0)
+    {
+        newData = static_cast<T*>(::operator new(newCapacity * sizeof(T), std::align_val_t(alignment), std::nothrow));
+
+        if (!newData)
+            return StdErrors::MemAllocErr;
+    }
+
+    size_t newSize = std::min(size_, newCapacity);
+    for (size_t pos = 0; pos < newSize; ++pos)
+        constructInMemory(newData + pos, data_[pos]);
+
+    free();
+
+    data_     = newData;
+    size_     = newSize;
+    capacity_ = newCapacity;
+
+    return StdErrors::Ok;
+}
+
+template<typename T, size_t alignment>
+void AlignedAllocator<T, alignment>::dtorElements(size_t fromPos, size_t to) noexcept
+{
+    for (size_t pos = fromPos; pos < to; ++pos)
+    {
+        data_[pos].~T();
+    }
+
+    size_ -= to - fromPos;
+}
+
+template<typename T, size_t alignment>
+AllocatorProxyValue<T> AlignedAllocator<T, alignment>::operator[](size_t pos)
+{
+    AllocatorProxyValue<T> proxy{data_, size_, capacity_, pos};
+    return proxy;
+}
+
+template<typename T, size_t alignment>
+const T& AlignedAllocator<T, alignment>::operator[](size_t pos) const
+{
+    return data_[pos];
+}
+
+template<typename T, size_t alignment>
+AlignedAllocator<T, alignment>::~AlignedAllocator()
+{
+    free();
+}
+
+} // namespace MyStd
+
+#endif // ALLOCATORS_ALIGNED_ALLOCATOR_HPP
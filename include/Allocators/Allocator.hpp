@@ -2,22 +2,33 @@
 #define ALLOCATORS_ALLOCATOR_HPP
 
 #include <cstddef>
+#include <type_traits>
 
 #include "Exceptions.hpp"
 
 namespace MyStd
 {
 
-template<typename T>
+// Allocators that keep capacity in a narrow type declare static constexpr size_t maxCapacity,
+// vector growth stops there instead of asking for a capacity they can't hold
+template<typename Allocator, typename = void>
+struct AllocatorMaxCapacity : std::integral_constant<size_t, static_cast<size_t>(-1)> {};
+
+template<typename Allocator>
+struct AllocatorMaxCapacity<Allocator, std::void_t<decltype(Allocator::maxCapacity)> > :
+    std::integral_constant<size_t, Allocator::maxCapacity> {};
+
+// SizeType is the type allocator keeps its size and capacity in
+template<typename T, typename SizeType = size_t>
 class AllocatorProxyValue final
 {
     T* data_;
-    size_t& size_;
-    size_t& capacity_;
+    SizeType& size_;
+    SizeType& capacity_;
     size_t pos_;
 
 public:
-    AllocatorProxyValue(T* data, size_t& size, size_t& capacity, size_t pos) : 
+    AllocatorProxyValue(T* data, SizeType& size, SizeType& capacity, size_t pos) : 
         data_(data), size_(size), capacity_(capacity), pos_(pos){}
 
     T& operator=(const T& value);
@@ -65,8 +76,8 @@ void copyToMemory(T* memory, const T& value)
     *memory = value;
 }
 
-template<typename T>
-T& AllocatorProxyValue<T>::operator=(const T& value)
+template<typename T, typename SizeType>
+T& AllocatorProxyValue<T, SizeType>::operator=(const T& value)
 {
     // NO CHECKS
     if (pos_ >= size_)
@@ -80,35 +91,35 @@ T& AllocatorProxyValue<T>::operator=(const T& value)
     return data_[pos_];
 }
 
-template<typename T>
-AllocatorProxyValue<T>::operator T&() noexcept
+template<typename T, typename SizeType>
+AllocatorProxyValue<T, SizeType>::operator T&() noexcept
 {
     return data_[pos_];
 }
 
-template<typename T>
-AllocatorProxyValue<T>::operator T*() noexcept
+template<typename T, typename SizeType>
+AllocatorProxyValue<T, SizeType>::operator T*() noexcept
 {
     return data_ + pos_;
 }
 
 #define CATCH_EXCEPTION(ERROR, REASON)  \
-    catch (ExceptionWithReason& exception) \
+    EXCEPTIONS_CATCH_WITH_REASON(exception) \
     { \
         allocator.dtorElements(fromPos, dataPos - 1); \
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(ERROR, REASON, std::move(exception)); \
+        THROW_EXCEPTION_WITH_REASON(ERROR, REASON, std::move(exception)); \
     } \
-    catch (...) \
+    EXCEPTIONS_CATCH(...) \
     { \
         allocator.dtorElements(fromPos, dataPos - 1); \
-        throw; \
+        EXCEPTIONS_RETHROW; \
     }
 
 template<typename T, typename Allocator>
 void copyData(Allocator& allocator, const size_t fromPos, size_t count, const T& value)
 {
     size_t dataPos = fromPos;
-    try
+    EXCEPTIONS_TRY
     {
         for (dataPos = fromPos; dataPos < count + fromPos; ++dataPos)
         {
@@ -122,7 +133,7 @@ template<typename T, typename Allocator>
 void copyData(Allocator& allocator, const size_t fromPos, T* otherData, size_t count)
 {
     size_t dataPos = fromPos;
-    try
+    EXCEPTIONS_TRY
     {
         for (size_t otherDataPos = fromPos; otherDataPos < count; ++otherDataPos)
         {
@@ -139,23 +150,23 @@ template<typename T>
 char* allocateMem(size_t size)
 {
     char* data = nullptr;
-    try
+    EXCEPTIONS_TRY
     {
         data = new char[size * sizeof(T)];
     }
-    catch(std::bad_alloc& exception)
+    EXCEPTIONS_CATCH(std::bad_alloc&)
     {
         delete [] data;
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::MemAllocErr,
             "Failed to allocate memory in allocator",
             {}
         );
     }
-    catch(...)
+    EXCEPTIONS_CATCH(...)
     {
         delete [] data;
-        throw;
+        EXCEPTIONS_RETHROW;
     }
 
     return data;
@@ -0,0 +1,286 @@
+#ifndef ALLOCATORS_COMPACT_ALLOCATOR_HPP
+#define ALLOCATORS_COMPACT_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "Allocators/Allocator.hpp"
+
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Same as DynamicAllocator without the IAllocator base, so there is no vtable pointer, and with size and
+// capacity kept in SizeType. Vector<T, CompactAllocator<T> > takes 16 bytes on 64-bit targets, which matters
+// for millions of small vectors. Vector growth stops at the largest SizeType, capacities past it are refused
+// with MemAllocErr
+template<typename T, typename SizeType = uint32_t>
+class CompactAllocator final
+{
+    static_assert(std::is_unsigned<SizeType>::value, "size type must be unsigned");
+
+    char* data_;
+    SizeType size_;
+    SizeType capacity_;
+
+public:
+    // Vector growth is capped here, so capacity can reach every value of SizeType
+    static constexpr size_t maxCapacity = std::numeric_limits<SizeType>::max();
+
+    CompactAllocator() noexcept : data_(nullptr), size_(0), capacity_(0) {}
+    CompactAllocator(size_t size);
+    CompactAllocator(size_t size, const T& value);
+    CompactAllocator(const CompactAllocator& other);
+
+    CompactAllocator& operator=(const CompactAllocator& other);
+
+    T* data() noexcept;
+
+    const T* data()   const noexcept;
+    size_t size()     const noexcept;
+    size_t capacity() const noexcept;
+
+    void size(const size_t newSize) noexcept;
+
+    void free() noexcept;
+    void realloc(size_t newCapacity);
+    void realloc(size_t newCapacity, const T& value);
+
+    // Never throws, elements must be nothrow copy constructible
+    StdErrors tryRealloc(size_t newCapacity) noexcept;
+
+    void dtorElements(size_t from, size_t to) noexcept;
+
+    AllocatorProxyValue<T, SizeType> operator[](size_t pos);
+    const T& operator[](size_t pos) const;
+
+    void swap(CompactAllocator& other) noexcept;
+
+    ~CompactAllocator();
+
+private:
+    static SizeType checkedCapacity(size_t requested);
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename SizeType>
+void CompactAllocator<T, SizeType>::swap(CompactAllocator& other) noexcept
+{
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template<typename T, typename SizeType>
+CompactAllocator<T, SizeType>::CompactAllocator(size_t size) :
+    data_(nullptr), size_(0), capacity_(checkedCapacity(size))
+{
+    data_ = allocateMem<T>(capacity_);
+}
+
+template<typename T, typename SizeType>
+CompactAllocator<T, SizeType>::CompactAllocator(size_t size, const T& value) :
+    data_(nullptr), size_(0), capacity_(checkedCapacity(size))
+{
+    data_ = allocateMem<T>(capacity_);
+
+    EXCEPTIONS_TRY
+    {
+        copyData(*this, 0, capacity_, value);
+    }
+    EXCEPTIONS_CATCH_WITH_REASON(e)
+    {
+        free();
+
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::AllocatorCtorErr,
+            "Can't copy into allocated memory in compact allocator",
+            std::move(e)
+        );
+    }
+    EXCEPTIONS_CATCH(...)
+    {
+        free();
+        EXCEPTIONS_RETHROW;
+    }
+}
+
+template<typename T, typename SizeType>
+CompactAllocator<T, SizeType>::CompactAllocator(const CompactAllocator& other) :
+    data_(nullptr), size_(0), capacity_(other.capacity_)
+{
+    data_ = allocateMem<T>(capacity_);
+    EXCEPTIONS_TRY
+    {
+        copyData(*this, 0, reinterpret_cast<T*>(other.data_), other.size_);
+    }
+    EXCEPTIONS_CATCH_WITH_REASON(e)
+    {
+        free();
+
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::AllocatorCtorErr,
+            "Can't copy into allocated memory in compact allocator",
+            std::move(e)
+        );
+    }
+    EXCEPTIONS_CATCH(...)
+    {
+        free();
+        EXCEPTIONS_RETHROW;
+    }
+}
+
+template<typename T, typename SizeType>
+CompactAllocator<T, SizeType>& CompactAllocator<T, SizeType>::operator=(const CompactAllocator& other)
+{
+    CompactAllocator<T, SizeType> tmp{other};
+    swap(tmp);
+
+    return *this;
+}
+
+template<typename T, typename SizeType>
+T* CompactAllocator<T, SizeType>::data() noexcept
+{
+    return reinterpret_cast<T*>(data_);
+}
+
+template<typename T, typename SizeType>
+const T* CompactAllocator<T, SizeType>::data() const noexcept
+{
+    return reinterpret_cast<const T*>(data_);
+}
+
+template<typename T, typename SizeType>
+size_t CompactAllocator<T, SizeType>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, typename SizeType>
+size_t CompactAllocator<T, SizeType>::capacity() const noexcept
+{
+    return capacity_;
+}
+
+template<typename T, typename SizeType>
+void CompactAllocator<T, SizeType>::size(const size_t newSize) noexcept
+{
+    // Never above capacity, which fits SizeType
+    size_ = static_cast<SizeType>(newSize);
+}
+
+template<typename T, typename SizeType>
+void CompactAllocator<T, SizeType>::free() noexcept
+{
+    dtorElements(0, size_);
+    delete [] data_;
+}
+
+template<typename T, typename SizeType>
+void CompactAllocator<T, SizeType>::realloc(size_t newCapacity)
+{
+    CompactAllocator<T, SizeType> tmp{newCapacity};
+
+    copyData(tmp, 0, reinterpret_cast<T*>(data_), std::min<size_t>(size_, newCapacity));
+
+    swap(tmp);
+}
+
+template<typename T, typename SizeType>
+void CompactAllocator<T, SizeType>::realloc(size_t newCapacity, const T& value)
+{
+    CompactAllocator<T, SizeType> tmp{newCapacity, value};
+
+    copyData(tmp, 0, reinterpret_cast<T*>(data_), std::min<size_t>(size_, newCapacity));
+
+    swap(tmp);
+}
+
+template<typename T, typename SizeType>
+StdErrors CompactAllocator<T, SizeType>::tryRealloc(size_t newCapacity) noexcept
+{
+    static_assert(std::is_nothrow_copy_constructible<T>::value, "tryRealloc can't copy elements that may throw");
+
+    if (newCapacity > std::numeric_limits<SizeType>::max() || newCapacity > static_cast<size_t>(-1) / sizeof(T))
+        return StdErrors::MemAllocErr;
+
+    char* newData = new (std::nothrow) char[newCapacity * sizeof(T)];
+
+    if (!newData)
+        return StdErrors::MemAllocErr;
+
+    size_t newSize = std::min<size_t>(size_, newCapacity);
+
+    T* oldElements = reinterpret_cast<T*>(data_);
+    T* newElements = reinterpret_cast<T*>(newData);
+    for (size_t pos = 0; pos < newSize; ++pos)
+        constructInMemory(newElements + pos, oldElements[pos]);
+
+    free();
+
+    data_     = newData;
+    size_     = static_cast<SizeType>(newSize);
+    capacity_ = static_cast<SizeType>(newCapacity);
+
+    return StdErrors::Ok;
+}
+
+template<typename T, typename SizeType>
+void CompactAllocator<T, SizeType>::dtorElements(size_t fromPos, size_t to) noexcept
+{
+    T* typedData = reinterpret_cast<T*>(data_);
+    for (size_t pos = fromPos; pos < to; ++pos)
+    {
+        typedData[pos].~T();
+    }
+
+    size_ = static_cast<SizeType>(size_ - (to - fromPos));
+}
+
+template<typename T, typename SizeType>
+AllocatorProxyValue<T, SizeType> CompactAllocator<T, SizeType>::operator[](size_t pos)
+{
+    AllocatorProxyValue<T, SizeType> proxy{reinterpret_cast<T*>(data_), size_, capacity_, pos};
+    return proxy;
+}
+
+template<typename T, typename SizeType>
+const T& CompactAllocator<T, SizeType>::operator[](size_t pos) const
+{
+    return reinterpret_cast<const T*>(data_)[pos];
+}
+
+template<typename T, typename SizeType>
+CompactAllocator<T, SizeType>::~CompactAllocator()
+{
+    free();
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T, typename SizeType>
+SizeType CompactAllocator<T, SizeType>::checkedCapacity(size_t requested)
+{
+    if (requested > std::numeric_limits<SizeType>::max())
+    {
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::MemAllocErr,
+            "Capacity doesn't fit size type of compact allocator",
+            {}
+        );
+    }
+
+    return static_cast<SizeType>(requested);
+}
+
+} // namespace MyStd
+
+#endif // ALLOCATORS_COMPACT_ALLOCATOR_HPP
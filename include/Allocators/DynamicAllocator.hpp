@@ -1,6 +1,10 @@
 #ifndef DYNAMIC_ALLOCATOR_HPP
 #define DYNAMIC_ALLOCATOR_HPP
 
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
 #include "Allocators/Allocator.hpp"
 
 #include "Exceptions.hpp"
@@ -8,7 +12,13 @@
 namespace MyStd
 {
 
-template<typename T>
+// Release policies get a buffer whose elements are already destroyed and decide when its memory is freed
+struct ImmediateRelease
+{
+    static void release(char* buffer, size_t) noexcept { delete [] buffer; }
+};
+
+template<typename T, typename Release = ImmediateRelease>
 class DynamicAllocator final : public IAllocator<T>
 {
     char* data_;
@@ -35,6 +45,10 @@ public:
     void free() noexcept override;
     void realloc(size_t newCapacity) override;
     void realloc(size_t newCapacity, const T& value) override;
+
+    // Never throws, elements must be nothrow copy constructible
+    StdErrors tryRealloc(size_t newCapacity) noexcept;
+
     void dtorElements(size_t from, size_t to) noexcept override;
     
     AllocatorProxyValue<T> operator[](size_t pos) override;
@@ -47,139 +61,168 @@ public:
 
 // --------------------------Implementation-----------------------------------
 
-template<typename T>
-void DynamicAllocator<T>::swap(DynamicAllocator& other) noexcept
+template<typename T, typename Release>
+void DynamicAllocator<T, Release>::swap(DynamicAllocator& other) noexcept
 {
     std::swap(data_, other.data_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
 }
 
-template<typename T>
-DynamicAllocator<T>::DynamicAllocator(size_t size) : size_(0), capacity_(size)
+template<typename T, typename Release>
+DynamicAllocator<T, Release>::DynamicAllocator(size_t size) : size_(0), capacity_(size)
 {
     data_ = allocateMem<T>(capacity_);
 }
     
-template<typename T>
-DynamicAllocator<T>::DynamicAllocator(size_t size, const T& value) : size_(0), capacity_(size)
+template<typename T, typename Release>
+DynamicAllocator<T, Release>::DynamicAllocator(size_t size, const T& value) : size_(0), capacity_(size)
 {
     data_ = allocateMem<T>(capacity_);
 
-    try
+    EXCEPTIONS_TRY
     {
         copyData(*this, 0, capacity_, value);
     }
-    catch (ExceptionWithReason& e)
+    EXCEPTIONS_CATCH_WITH_REASON(e)
     {
         free();
 
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::AllocatorCtorErr,
             "Can't copy into allocated memory in dynamic allocator",
             std::move(e)
         );
     }
-    catch(...)
+    EXCEPTIONS_CATCH(...)
     {
         free();
-        throw;
+        EXCEPTIONS_RETHROW;
     }    
 }
 
-template<typename T>
-DynamicAllocator<T>::DynamicAllocator(const DynamicAllocator& other) : size_(0), capacity_(other.capacity_)
+template<typename T, typename Release>
+DynamicAllocator<T, Release>::DynamicAllocator(const DynamicAllocator& other) : size_(0), capacity_(other.capacity_)
 {
     data_ = allocateMem<T>(capacity_);
-    try
+    EXCEPTIONS_TRY
     {
         copyData(*this, 0, reinterpret_cast<T*>(other.data_), other.size_);
     }
-    catch (ExceptionWithReason& e)
+    EXCEPTIONS_CATCH_WITH_REASON(e)
     {
         free();
 
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::AllocatorCtorErr,
             "Can't copy into allocated memory in dynamic allocator",
             std::move(e)
         );
     }
-    catch(...)
+    EXCEPTIONS_CATCH(...)
     {
         free();
-        throw;
+        EXCEPTIONS_RETHROW;
     }  
 }
 
-template<typename T>
-DynamicAllocator<T>& DynamicAllocator<T>::operator=(const DynamicAllocator& other)
+template<typename T, typename Release>
+DynamicAllocator<T, Release>& DynamicAllocator<T, Release>::operator=(const DynamicAllocator& other)
 {
-    DynamicAllocator<T> tmp{other};
+    DynamicAllocator<T, Release> tmp{other};
     swap(tmp);
 
     return *this;
 }
 
-template<typename T>
-T* DynamicAllocator<T>::data() noexcept
+template<typename T, typename Release>
+T* DynamicAllocator<T, Release>::data() noexcept
 {
     return reinterpret_cast<T*>(data_);
 }
 
-template<typename T>
-const T* DynamicAllocator<T>::data() const noexcept
+template<typename T, typename Release>
+const T* DynamicAllocator<T, Release>::data() const noexcept
 {
     return reinterpret_cast<const T*>(data_);
 }
 
-template<typename T>
-size_t DynamicAllocator<T>::size() const noexcept
+template<typename T, typename Release>
+size_t DynamicAllocator<T, Release>::size() const noexcept
 {
     return size_;
 }
 
-template<typename T>
-size_t DynamicAllocator<T>::capacity() const noexcept
+template<typename T, typename Release>
+size_t DynamicAllocator<T, Release>::capacity() const noexcept
 {
     return capacity_;
 }
 
-template<typename T>
-void DynamicAllocator<T>::size(const size_t newSize) noexcept
+template<typename T, typename Release>
+void DynamicAllocator<T, Release>::size(const size_t newSize) noexcept
 {
     size_ = newSize;
 }
 
-template<typename T>
-void DynamicAllocator<T>::free() noexcept
+template<typename T, typename Release>
+void DynamicAllocator<T, Release>::free() noexcept
 {
     dtorElements(0, size_);
-    delete [] data_;
+    Release::release(data_, capacity_ * sizeof(T));
 }
 
-template<typename T>
-void DynamicAllocator<T>::realloc(size_t newCapacity)
+template<typename T, typename Release>
+void DynamicAllocator<T, Release>::realloc(size_t newCapacity)
 {
-    DynamicAllocator<T> tmp{newCapacity};
+    DynamicAllocator<T, Release> tmp{newCapacity};
 
     copyData(tmp, 0, reinterpret_cast<T*>(data_), std::min(size_, newCapacity));
 
     swap(tmp);
 }
 
-template<typename T>
-void DynamicAllocator<T>::realloc(size_t newCapacity, const T& value)
+template<typename T, typename Release>
+void DynamicAllocator<T, Release>::realloc(size_t newCapacity, const T& value)
 {
-    DynamicAllocator<T> tmp{newCapacity, value};
+    DynamicAllocator<T, Release> tmp{newCapacity, value};
 
     copyData(tmp, 0, reinterpret_cast<T*>(data_), std::min(size_, newCapacity));
 
     swap(tmp);
 }
 
-template<typename T>
-void DynamicAllocator<T>::dtorElements(size_t fromPos, size_t to) noexcept
+template<typename T, typename Release>
+StdErrors DynamicAllocator<T, Release>::tryRealloc(size_t newCapacity) noexcept
+{
+    static_assert(std::is_nothrow_copy_constructible<T>::value, "tryRealloc can't copy elements that may throw");
+
+    if (newCapacity > static_cast<size_t>(-1) / sizeof(T))
+        return StdErrors::MemAllocErr;
+
+    char* newData = new (std::nothrow) char[newCapacity * sizeof(T)];
+
+    if (!newData)
+        return StdErrors::MemAllocErr;
+
+    size_t newSize = std::min(size_, newCapacity);
+
+    T* oldElements = reinterpret_cast<T*>(data_);
+    T* newElements = reinterpret_cast<T*>(newData);
+    for (size_t pos = 0; pos < newSize; ++pos)
+        constructInMemory(newElements + pos, oldElements[pos]);
+
+    free();
+
+    data_     = newData;
+    size_     = newSize;
+    capacity_ = newCapacity;
+
+    return StdErrors::Ok;
+}
+
+template<typename T, typename Release>
+void DynamicAllocator<T, Release>::dtorElements(size_t fromPos, size_t to) noexcept
 {
     T* typedData = reinterpret_cast<T*>(data_);
     for (size_t pos = fromPos; pos < to; ++pos)
@@ -190,21 +233,21 @@ void DynamicAllocator<T>::dtorElements(size_t fromPos, size_t to) noexcept
     size_ -= to - fromPos;
 }
 
-template<typename T>
-AllocatorProxyValue<T> DynamicAllocator<T>::operator[](size_t pos)
+template<typename T, typename Release>
+AllocatorProxyValue<T> DynamicAllocator<T, Release>::operator[](size_t pos)
 {
     AllocatorProxyValue<T> proxy{reinterpret_cast<T*>(data_), size_, capacity_, pos};
     return proxy;
 }
 
-template<typename T>
-const T& DynamicAllocator<T>::operator[](size_t pos) const
+template<typename T, typename Release>
+const T& DynamicAllocator<T, Release>::operator[](size_t pos) const
 {
     return reinterpret_cast<const T*>(data_)[pos];
 }
 
-template<typename T>
-DynamicAllocator<T>::~DynamicAllocator()
+template<typename T, typename Release>
+DynamicAllocator<T, Release>::~DynamicAllocator()
 {
     free();
 }
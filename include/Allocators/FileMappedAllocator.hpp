@@ -0,0 +1,466 @@
+#ifndef ALLOCATORS_FILE_MAPPED_ALLOCATOR_HPP
+#define ALLOCATORS_FILE_MAPPED_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Allocators/Allocator.hpp"
+
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+enum class FileMapMode
+{
+    ReadWrite, // changes go to the file, shared with every process that mapped it
+    ReadOnly,  // many processes share one page cache copy, writing through data() crashes
+};
+
+// Element buffer lives in an mmap'd file: one header page with the element count, then the elements.
+// Capacity is the file length, so growing capacity grows the file. Allocators made by the usual
+// constructors (and copies) map anonymous memory instead, only create() and open() are backed by a file.
+template<typename T>
+class FileMappedAllocator final : public IAllocator<T>
+{
+    static_assert(std::is_trivially_copyable<T>::value, "file mapped elements are stored as raw bytes");
+
+    struct FileHeader
+    {
+        uint64_t magic;
+        uint64_t elementSize;
+        uint64_t size;
+    };
+
+    static constexpr uint64_t fileMagic  = 0x4D56465031ull; // "1PFVM"
+    static constexpr size_t   headerSize = 4096;            // keeps elements page aligned
+
+    static_assert(alignof(T) <= headerSize, "elements must fit the header page alignment");
+
+    uint8_t* base_;   // header page followed by capacity_ elements
+    size_t size_;
+    size_t capacity_;
+
+    int fd_;          // -1 for anonymous memory
+    bool readOnly_;
+
+public:
+    FileMappedAllocator() noexcept;
+    FileMappedAllocator(size_t size);
+    FileMappedAllocator(size_t size, const T& value);
+    FileMappedAllocator(const FileMappedAllocator& other);
+    FileMappedAllocator(FileMappedAllocator&& other) noexcept;
+
+    FileMappedAllocator& operator=(const FileMappedAllocator& other);
+    FileMappedAllocator& operator=(FileMappedAllocator&& other) noexcept;
+
+    // Truncates the file
+    static FileMappedAllocator create(const char* path, size_t capacity = 0);
+
+    // Maps file written by create() as is, nothing is copied or read until touched
+    static FileMappedAllocator open(const char* path, FileMapMode mode = FileMapMode::ReadWrite);
+
+    T* data() noexcept override;
+
+    const T* data()   const noexcept override;
+    size_t size()     const noexcept override;
+    size_t capacity() const noexcept override;
+
+    void size(const size_t newSize) noexcept override;
+
+    bool isFileBacked() const noexcept;
+    bool isReadOnly  () const noexcept;
+
+    // Stores element count in the header and flushes dirty pages to disk
+    void sync();
+
+    // Element count is stored in the file before unmapping, so free never loses data
+    void free() noexcept override;
+    void realloc(size_t newCapacity) override;
+    void realloc(size_t newCapacity, const T& value) override;
+    void dtorElements(size_t from, size_t to) noexcept override;
+
+    AllocatorProxyValue<T> operator[](size_t pos) override;
+    const T& operator[](size_t pos) const override;
+
+    void swap(FileMappedAllocator& other) noexcept;
+
+    ~FileMappedAllocator();
+
+private:
+    FileMappedAllocator(int fd, bool readOnly) noexcept;
+
+    static size_t mappingSize(size_t capacity) noexcept;
+
+    // Reads the header with pread, returns reason to refuse the file or nullptr
+    static const char* checkFile(int fd, size_t& capacity, size_t& size) noexcept;
+
+    FileHeader* header() noexcept;
+    void storeSize() noexcept;
+
+    void remap(size_t newCapacity);
+
+    [[noreturn]] static void throwFileMapErr(const char* reason);
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T>
+FileMappedAllocator<T>::FileMappedAllocator() noexcept :
+    base_(nullptr), size_(0), capacity_(0), fd_(-1), readOnly_(false)
+{
+}
+
+template<typename T>
+FileMappedAllocator<T>::FileMappedAllocator(int fd, bool readOnly) noexcept :
+    base_(nullptr), size_(0), capacity_(0), fd_(fd), readOnly_(readOnly)
+{
+}
+
+template<typename T>
+FileMappedAllocator<T>::FileMappedAllocator(size_t size) : FileMappedAllocator()
+{
+    remap(size);
+}
+
+template<typename T>
+FileMappedAllocator<T>::FileMappedAllocator(size_t size, const T& value) : FileMappedAllocator(size)
+{
+    copyData(*this, 0, capacity_, value);
+}
+
+template<typename T>
+FileMappedAllocator<T>::FileMappedAllocator(const FileMappedAllocator& other) : FileMappedAllocator(other.capacity_)
+{
+    if (other.size_ != 0)
+        memcpy(data(), other.data(), other.size_ * sizeof(T));
+
+    size_ = other.size_;
+}
+
+template<typename T>
+FileMappedAllocator<T>::FileMappedAllocator(FileMappedAllocator&& other) noexcept : FileMappedAllocator()
+{
+    swap(other);
+}
+
+template<typename T>
+FileMappedAllocator<T>& FileMappedAllocator<T>::operator=(const FileMappedAllocator& other)
+{
+    FileMappedAllocator tmp{other};
+    swap(tmp);
+
+    return *this;
+}
+
+template<typename T>
+FileMappedAllocator<T>& FileMappedAllocator<T>::operator=(FileMappedAllocator&& other) noexcept
+{
+    FileMappedAllocator tmp{std::move(other)};
+    swap(tmp);
+
+    return *this;
+}
+
+template<typename T>
+FileMappedAllocator<T> FileMappedAllocator<T>::create(const char* path, size_t capacity)
+{
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0)
+        throwFileMapErr("Failed to create file for file mapped allocator");
+
+    FileMappedAllocator allocator{fd, false};
+
+    allocator.remap(capacity);
+
+    FileHeader* header  = allocator.header();
+    header->magic       = fileMagic;
+    header->elementSize = sizeof(T);
+    header->size        = 0;
+
+    return allocator;
+}
+
+template<typename T>
+FileMappedAllocator<T> FileMappedAllocator<T>::open(const char* path, FileMapMode mode)
+{
+    bool readOnly = mode == FileMapMode::ReadOnly;
+
+    int fd = ::open(path, (readOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+
+    if (fd < 0)
+        throwFileMapErr("Failed to open file for file mapped allocator");
+
+    // Checked before an allocator owns the file: its destructor stores the size into the header,
+    // and a refused file must stay untouched
+    size_t capacity = 0;
+    size_t size     = 0;
+
+    if (const char* reason = checkFile(fd, capacity, size))
+    {
+        ::close(fd);
+        throwFileMapErr(reason);
+    }
+
+    FileMappedAllocator allocator{fd, readOnly};
+
+    allocator.remap(capacity);
+    allocator.size_ = size;
+
+    return allocator;
+}
+
+template<typename T>
+T* FileMappedAllocator<T>::data() noexcept
+{
+    return base_ ? reinterpret_cast<T*>(base_ + headerSize) : nullptr;
+}
+
+template<typename T>
+const T* FileMappedAllocator<T>::data() const noexcept
+{
+    return base_ ? reinterpret_cast<const T*>(base_ + headerSize) : nullptr;
+}
+
+template<typename T>
+size_t FileMappedAllocator<T>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T>
+size_t FileMappedAllocator<T>::capacity() const noexcept
+{
+    return capacity_;
+}
+
+template<typename T>
+void FileMappedAllocator<T>::size(const size_t newSize) noexcept
+{
+    size_ = newSize;
+}
+
+template<typename T>
+bool FileMappedAllocator<T>::isFileBacked() const noexcept
+{
+    return fd_ >= 0;
+}
+
+template<typename T>
+bool FileMappedAllocator<T>::isReadOnly() const noexcept
+{
+    return readOnly_;
+}
+
+template<typename T>
+void FileMappedAllocator<T>::sync()
+{
+    if (!isFileBacked() || readOnly_)
+        return;
+
+    storeSize();
+
+    if (msync(base_, mappingSize(capacity_), MS_SYNC) != 0)
+        throwFileMapErr("Failed to flush mapped file");
+}
+
+template<typename T>
+void FileMappedAllocator<T>::free() noexcept
+{
+    storeSize();
+
+    if (base_)
+        munmap(base_, mappingSize(capacity_));
+
+    if (fd_ >= 0)
+        ::close(fd_);
+
+    base_     = nullptr;
+    size_     = 0;
+    capacity_ = 0;
+    fd_       = -1;
+    readOnly_ = false;
+}
+
+template<typename T>
+void FileMappedAllocator<T>::realloc(size_t newCapacity)
+{
+    if (readOnly_)
+        throwFileMapErr("Can't resize read only mapped file");
+
+    remap(newCapacity);
+}
+
+template<typename T>
+void FileMappedAllocator<T>::realloc(size_t newCapacity, const T& value)
+{
+    realloc(newCapacity);
+    copyData(*this, size_, capacity_ - size_, value);
+}
+
+template<typename T>
+void FileMappedAllocator<T>::dtorElements(size_t fromPos, size_t to) noexcept
+{
+    size_ -= to - fromPos;
+}
+
+template<typename T>
+AllocatorProxyValue<T> FileMappedAllocator<T>::operator[](size_t pos)
+{
+    AllocatorProxyValue<T> proxy{data(), size_, capacity_, pos};
+    return proxy;
+}
+
+template<typename T>
+const T& FileMappedAllocator<T>::operator[](size_t pos) const
+{
+    return data()[pos];
+}
+
+template<typename T>
+void FileMappedAllocator<T>::swap(FileMappedAllocator& other) noexcept
+{
+    std::swap(base_, other.base_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(fd_, other.fd_);
+    std::swap(readOnly_, other.readOnly_);
+}
+
+template<typename T>
+FileMappedAllocator<T>::~FileMappedAllocator()
+{
+    free();
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T>
+size_t FileMappedAllocator<T>::mappingSize(size_t capacity) noexcept
+{
+    return headerSize + capacity * sizeof(T);
+}
+
+template<typename T>
+const char* FileMappedAllocator<T>::checkFile(int fd, size_t& capacity, size_t& size) noexcept
+{
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0)
+        return "Failed to get size of mapped file";
+
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    if (fileSize < headerSize || (fileSize - headerSize) % sizeof(T) != 0)
+        return "Mapped file has broken layout";
+
+    FileHeader fileHeader = {};
+    if (pread(fd, &fileHeader, sizeof(fileHeader), 0) != static_cast<ssize_t>(sizeof(fileHeader)))
+        return "Failed to read header of mapped file";
+
+    capacity = (fileSize - headerSize) / sizeof(T);
+
+    if (fileHeader.magic != fileMagic || fileHeader.elementSize != sizeof(T) || fileHeader.size > capacity)
+        return "Mapped file was not written by file mapped allocator of this type";
+
+    size = static_cast<size_t>(fileHeader.size);
+
+    return nullptr;
+}
+
+template<typename T>
+typename FileMappedAllocator<T>::FileHeader* FileMappedAllocator<T>::header() noexcept
+{
+    return reinterpret_cast<FileHeader*>(base_);
+}
+
+template<typename T>
+void FileMappedAllocator<T>::storeSize() noexcept
+{
+    if (base_ && isFileBacked() && !readOnly_)
+        header()->size = size_;
+}
+
+template<typename T>
+void FileMappedAllocator<T>::remap(size_t newCapacity)
+{
+    size_t oldMappingSize = base_ ? mappingSize(capacity_) : 0;
+    size_t newMappingSize = mappingSize(newCapacity);
+
+    // File grows before the mapping and shrinks after it, so no mapped page is ever past the end of file
+    bool resizesFile = isFileBacked() && !readOnly_;
+    bool growsFile   = resizesFile && newMappingSize > oldMappingSize;
+
+    if (growsFile && ftruncate(fd_, static_cast<off_t>(newMappingSize)) != 0)
+        throwFileMapErr("Failed to resize mapped file");
+
+    void* newBase = MAP_FAILED;
+
+    if (base_)
+    {
+        // Pages are moved by the kernel, elements are never copied
+        newBase = mremap(base_, oldMappingSize, newMappingSize, MREMAP_MAYMOVE);
+    }
+    else if (isFileBacked())
+    {
+        int protection = readOnly_ ? PROT_READ : PROT_READ | PROT_WRITE;
+        newBase = mmap(nullptr, newMappingSize, protection, MAP_SHARED, fd_, 0);
+    }
+    else
+    {
+        newBase = mmap(nullptr, newMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (newBase == MAP_FAILED)
+    {
+        int mapErrno = errno;
+
+        // Old mapping is still in place, the file goes back to its length
+        if (growsFile && base_)
+            (void)ftruncate(fd_, static_cast<off_t>(oldMappingSize));
+
+        if (mapErrno == ENOMEM)
+        {
+            THROW_EXCEPTION_WITH_REASON(
+                StdErrors::MemAllocErr,
+                "Failed to map memory in file mapped allocator",
+                {}
+            );
+        }
+
+        throwFileMapErr("Failed to map file");
+    }
+
+    base_     = static_cast<uint8_t*>(newBase);
+    capacity_ = newCapacity;
+    size_     = std::min(size_, newCapacity);
+
+    // A file left longer than the mapping is still a valid layout, open() just sees more capacity
+    if (resizesFile && !growsFile && newMappingSize != oldMappingSize &&
+        ftruncate(fd_, static_cast<off_t>(newMappingSize)) != 0)
+    {
+        throwFileMapErr("Failed to shrink mapped file");
+    }
+}
+
+template<typename T>
+void FileMappedAllocator<T>::throwFileMapErr(const char* reason)
+{
+    THROW_EXCEPTION_WITH_REASON(
+        StdErrors::FileMapErr,
+        reason,
+        {}
+    );
+}
+
+} // namespace MyStd
+
+#endif // ALLOCATORS_FILE_MAPPED_ALLOCATOR_HPP
@@ -0,0 +1,175 @@
+#ifndef ALLOCATORS_SHRINKING_ALLOCATOR_HPP
+#define ALLOCATORS_SHRINKING_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Allocators/Allocator.hpp"
+#include "Allocators/DynamicAllocator.hpp"
+
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Opt-in shrink policy over another allocator: destroying elements gives memory back once fewer than
+// a quarter of the slots are used, capacity then drops to twice the size. Growth leaves the buffer about
+// half full and a shrink leaves it exactly half full, so the size has to halve or double before the next
+// reallocation and push/pop cycles around one size never thrash. Capacity never drops below minCapacity
+template<typename T, typename Base = DynamicAllocator<T>, size_t minCapacity = 16>
+class ShrinkingAllocator final : public IAllocator<T>
+{
+    static constexpr size_t shrinkBelowDivisor = 4;
+    static constexpr size_t shrinkToMultiplier = 2;
+
+    Base base_;
+
+public:
+    ShrinkingAllocator() : base_() {}
+    ShrinkingAllocator(size_t size) : base_(size) {}
+    ShrinkingAllocator(size_t size, const T& value) : base_(size, value) {}
+
+    T* data() noexcept override;
+
+    const T* data()   const noexcept override;
+    size_t size()     const noexcept override;
+    size_t capacity() const noexcept override;
+
+    void size(const size_t newSize) noexcept override;
+
+    void free() noexcept override;
+    void realloc(size_t newCapacity) override;
+    void realloc(size_t newCapacity, const T& value) override;
+
+    // Never throws, elements must be nothrow copy constructible
+    StdErrors tryRealloc(size_t newCapacity) noexcept;
+
+    // Shrinks afterwards if occupancy fell under the threshold. A failed shrink keeps the old buffer
+    void dtorElements(size_t from, size_t to) noexcept override;
+
+    AllocatorProxyValue<T> operator[](size_t pos) override;
+    const T& operator[](size_t pos) const override;
+
+    void swap(ShrinkingAllocator& other) noexcept(noexcept(std::declval<Base&>().swap(std::declval<Base&>())));
+
+private:
+    void shrinkIfSparse() noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Base, size_t minCapacity>
+T* ShrinkingAllocator<T, Base, minCapacity>::data() noexcept
+{
+    return base_.data();
+}
+
+template<typename T, typename Base, size_t minCapacity>
+const T* ShrinkingAllocator<T, Base, minCapacity>::data() const noexcept
+{
+    return base_.data();
+}
+
+template<typename T, typename Base, size_t minCapacity>
+size_t ShrinkingAllocator<T, Base, minCapacity>::size() const noexcept
+{
+    return base_.size();
+}
+
+template<typename T, typename Base, size_t minCapacity>
+size_t ShrinkingAllocator<T, Base, minCapacity>::capacity() const noexcept
+{
+    return base_.capacity();
+}
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::size(const size_t newSize) noexcept
+{
+    base_.size(newSize);
+}
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::free() noexcept
+{
+    base_.free();
+}
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::realloc(size_t newCapacity)
+{
+    base_.realloc(newCapacity);
+}
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::realloc(size_t newCapacity, const T& value)
+{
+    base_.realloc(newCapacity, value);
+}
+
+template<typename T, typename Base, size_t minCapacity>
+StdErrors ShrinkingAllocator<T, Base, minCapacity>::tryRealloc(size_t newCapacity) noexcept
+{
+    return base_.tryRealloc(newCapacity);
+}
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::dtorElements(size_t from, size_t to) noexcept
+{
+    base_.dtorElements(from, to);
+
+    shrinkIfSparse();
+}
+
+template<typename T, typename Base, size_t minCapacity>
+AllocatorProxyValue<T> ShrinkingAllocator<T, Base, minCapacity>::operator[](size_t pos)
+{
+    return base_[pos];
+}
+
+template<typename T, typename Base, size_t minCapacity>
+const T& ShrinkingAllocator<T, Base, minCapacity>::operator[](size_t pos) const
+{
+    return base_[pos];
+}
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::swap(ShrinkingAllocator& other)
+    noexcept(noexcept(std::declval<Base&>().swap(std::declval<Base&>())))
+{
+    base_.swap(other.base_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T, typename Base, size_t minCapacity>
+void ShrinkingAllocator<T, Base, minCapacity>::shrinkIfSparse() noexcept
+{
+    size_t oldCapacity = base_.capacity();
+
+    if (oldCapacity <= minCapacity || base_.size() >= oldCapacity / shrinkBelowDivisor)
+        return;
+
+    size_t newCapacity = std::max(base_.size() * shrinkToMultiplier, minCapacity);
+
+    if constexpr (std::is_nothrow_copy_constructible<T>::value)
+    {
+        base_.tryRealloc(newCapacity);
+    }
+    else
+    {
+        // Shrinking is only an optimization, elements stay where they are if copying them fails
+        EXCEPTIONS_TRY
+        {
+            base_.realloc(newCapacity);
+        }
+        EXCEPTIONS_CATCH(...)
+        {
+        }
+    }
+}
+
+} // namespace MyStd
+
+#endif // ALLOCATORS_SHRINKING_ALLOCATOR_HPP
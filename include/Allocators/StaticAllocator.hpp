@@ -1,7 +1,10 @@
 #ifndef ALLOCATORS_STATIC_ALLOCATOR
 #define ALLOCATORS_STATIC_ALLOCATOR
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <utility>
 
 #include "Allocators/Allocator.hpp"
 
@@ -35,6 +38,10 @@ public:
     void free() override;
     void realloc(size_t newCapacity) override;
     void realloc(size_t newCapacity, const T& value) override;
+
+    // Never throws, fails when newCapacity doesn't fit into the static buffer
+    StdErrors tryRealloc(size_t newCapacity) noexcept;
+
     void dtorElements(size_t from, size_t to) override;
     
     AllocatorProxyValue<T> operator[](size_t pos) override;
@@ -52,7 +59,27 @@ public:
 template<typename T, size_t initCapacity>
 void StaticAllocator<T, initCapacity>::swap(StaticAllocator& other)
 {
-    copyData(*this, 0, reinterpret_cast<T*>(other.data_), other.size_);
+    // Buffers are inline, so elements themselves change places: common prefix is swapped,
+    // the longer tail is copied over and destroyed at its old place
+    T* typedData      = reinterpret_cast<T*>(data_);
+    T* otherTypedData = reinterpret_cast<T*>(other.data_);
+
+    size_t common = std::min(size_, other.size_);
+    for (size_t pos = 0; pos < common; ++pos)
+    {
+        T tmp{typedData[pos]};
+        copyToMemory(typedData + pos, otherTypedData[pos]);
+        copyToMemory(otherTypedData + pos, tmp);
+    }
+
+    T* longer  = size_ > other.size_ ? typedData : otherTypedData;
+    T* shorter = size_ > other.size_ ? otherTypedData : typedData;
+    for (size_t pos = common, longerSize = std::max(size_, other.size_); pos < longerSize; ++pos)
+    {
+        constructInMemory(shorter + pos, longer[pos]);
+        longer[pos].~T();
+    }
+
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
 }
@@ -62,7 +89,7 @@ StaticAllocator<T, initCapacity>::StaticAllocator(size_t size) : size_(0)
 {
     if (size > capacity_)
     {
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorOnStackNotEnoughMemory,
             "Can't allocate [SIZE] elements on stack, not enough memory",
             {}
@@ -73,24 +100,24 @@ StaticAllocator<T, initCapacity>::StaticAllocator(size_t size) : size_(0)
 template<typename T, size_t initCapacity>
 StaticAllocator<T, initCapacity>::StaticAllocator(size_t size, const T& value) : StaticAllocator(size)
 {
-    try
+    EXCEPTIONS_TRY
     {
         copyData(*this, 0, size, value);
     }
-    catch (ExceptionWithReason& e)
+    EXCEPTIONS_CATCH_WITH_REASON(e)
     {
         free();
 
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::AllocatorCtorErr,
             "Can't copy into allocated memory in static allocator",
             std::move(e)
         );
     }
-    catch(...)
+    EXCEPTIONS_CATCH(...)
     {
         free();
-        throw;
+        EXCEPTIONS_RETHROW;
     }    
 }
 
@@ -99,25 +126,25 @@ StaticAllocator<T, initCapacity>::StaticAllocator(const StaticAllocator& other)
 {
     assert(capacity_ == other.capacity_);
 
-    try
+    EXCEPTIONS_TRY
     {
         copyData(*this, 0, reinterpret_cast<const T*>(other.data_), other.size_);
         size_ = other.size_;
     }
-    catch (ExceptionWithReason& e)
+    EXCEPTIONS_CATCH_WITH_REASON(e)
     {
         free();
 
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::AllocatorCtorErr,
             "Can't copy into allocated memory in static allocator",
             std::move(e)
         );
     }
-    catch(...)
+    EXCEPTIONS_CATCH(...)
     {
         free();
-        throw;
+        EXCEPTIONS_RETHROW;
     }  
 }
 
@@ -186,6 +213,18 @@ void StaticAllocator<T, initCapacity>::realloc(size_t newCapacity, const T& valu
     swap(tmp);
 }
 
+template<typename T, size_t initCapacity>
+StdErrors StaticAllocator<T, initCapacity>::tryRealloc(size_t newCapacity) noexcept
+{
+    if (newCapacity > initCapacity)
+        return StdErrors::VectorOnStackNotEnoughMemory;
+
+    if (newCapacity < size_)
+        dtorElements(newCapacity, size_);
+
+    return StdErrors::Ok;
+}
+
 template<typename T, size_t initCapacity>
 void StaticAllocator<T, initCapacity>::dtorElements(size_t fromPos, size_t to)
 {
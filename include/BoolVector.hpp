@@ -47,10 +47,16 @@ public:
     ProxyValue back() noexcept;
     bool back() const noexcept;
 
+    uint8_t*       data() noexcept;
+    const uint8_t* data() const noexcept;
+
     bool   empty   () const noexcept;
     size_t size    () const noexcept;
     size_t capacity() const noexcept;
 
+    // Bytes of packed bits, a partly used last byte counts as live
+    VectorMemoryUsage memoryUsage() const noexcept;
+
     void reserve(size_t newCapacity);
 
     void shrinkToFit();
@@ -61,8 +67,18 @@ public:
 
     void resize(size_t newSize, const bool value = false);
 
+    // Bits appended this way are whatever was in memory, caller fills them through data()
+    void resizeUninitialized(size_t newSize);
+
     void swap(Vector& other);
 
+    // Non-throwing variants, Allocator must provide tryRealloc
+    StdErrors tryReserve(size_t newCapacity) noexcept;
+    StdErrors tryPushBack(const bool value) noexcept;
+    StdErrors tryResize(size_t newSize, const bool value = false) noexcept;
+
+    Expected<bool> tryAt(size_t pos) const noexcept;
+
 private:
     enum class PushResult
     {
@@ -2,6 +2,7 @@
 #define BOOL_VECTOR_IMPL_HPP
 
 #include <cassert>
+#include <cstring>
 #include <algorithm>
 
 #include "BoolVector.hpp"
@@ -27,7 +28,7 @@ inline void setBit(uint8_t* data, size_t pos, bool value)
     data[block] = value ? (data[block] | (1u << shift)) : (data[block] & ~(1u << shift));
 }
 
-inline bool getBit(uint8_t* data, size_t pos)
+inline bool getBit(const uint8_t* data, size_t pos)
 {
     size_t block = getBlock(pos);
     size_t shift = getShift(pos);
@@ -40,58 +41,53 @@ inline size_t getNeededSize(size_t size)
     return (size + __CHAR_BIT__ - 1) / __CHAR_BIT__;
 }
 
-inline bool needToIncreaseSizeInAllocator(size_t allocatorSize, size_t bitsSize)
-{   
-    return bitsSize / __CHAR_BIT__ > allocatorSize;
-}
-
 inline void copyData(uint8_t* data, uint8_t* from, size_t size)
 {
-    try
+    EXCEPTIONS_TRY
     {
         for (size_t i = 0; i < size; ++i)
         {
             setBit(data, i, getBit(from, i)); // TODO: could be more efficient
         }
     }
-    catch (ExceptionWithReason& exception)
+    EXCEPTIONS_CATCH_WITH_REASON(exception)
     {
         delete [] data;
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorCtorErr,
             "Failed to copy elements while copying vector",
             std::move(exception)
         );
     }
-    catch (...)
+    EXCEPTIONS_CATCH(...)
     {
         delete [] data;
-        throw;
+        EXCEPTIONS_RETHROW;
     }
 }
 
 inline void copyData(uint8_t* data, size_t size, const bool value)
 {
-    try
+    EXCEPTIONS_TRY
     {
         for (size_t i = 0; i < size; ++i)
         {
             setBit(data, i, value); // TODO: could be more efficient
         }
     }
-    catch (ExceptionWithReason& exception)
+    EXCEPTIONS_CATCH_WITH_REASON(exception)
     {
         delete [] data;
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorCtorErr,
             "Failed to copy elements while copying vector",
             std::move(exception)
         );
     }
-    catch (...)
+    EXCEPTIONS_CATCH(...)
     {
         delete [] data;
-        throw;
+        EXCEPTIONS_RETHROW;
     }
 }
 
@@ -123,7 +119,7 @@ template<typename Allocator>
 Vector<bool, Allocator>::Vector(size_t size, const bool value)
     : allocator_(getNeededSize(size), value), size_(size)
 {
-    copyData(allocator_.data(), size_, value);
+    copyData(data(), size_, value);
 }
 
 template<typename Allocator>
@@ -144,6 +140,43 @@ bool Vector<bool, Allocator>::empty() const noexcept
     return size_ == 0;
 }
 
+template<typename Allocator>
+size_t Vector<bool, Allocator>::capacity() const noexcept
+{
+    return allocator_.capacity() * __CHAR_BIT__;
+}
+
+template<typename Allocator>
+VectorMemoryUsage Vector<bool, Allocator>::memoryUsage() const noexcept
+{
+    size_t liveBytes = getNeededSize(size_);
+
+    return {liveBytes, allocator_.capacity() - liveBytes};
+}
+
+template<typename Allocator>
+void Vector<bool, Allocator>::reserve(size_t newCapacity)
+{
+    if (newCapacity <= capacity())
+        return;
+
+    Allocator newAllocator{getNeededSize(newCapacity)};
+
+    memcpy(newAllocator.data(), allocator_.data(), allocator_.size());
+    newAllocator.size(allocator_.size());
+
+    allocator_.swap(newAllocator);
+}
+
+template<typename Allocator>
+void Vector<bool, Allocator>::resizeUninitialized(size_t newSize)
+{
+    reserve(newSize);
+
+    allocator_.size(getNeededSize(newSize));
+    size_ = newSize;
+}
+
 template<typename Allocator>
 void Vector<bool, Allocator>::pushBack(const bool value)
 {
@@ -154,7 +187,7 @@ void Vector<bool, Allocator>::pushBack(const bool value)
 
     assert(pushResult == PushResult::NeedToResize);
 
-    Vector<bool, Allocator> newVector{getCapacityAfterGrowth(allocator_.capacity())};
+    Vector<bool, Allocator> newVector{getCapacityAfterGrowth(allocator_.capacity()) * __CHAR_BIT__};
 
     copyData(
         reinterpret_cast<uint8_t*>(newVector.allocator_.data()), 
@@ -202,6 +235,18 @@ bool Vector<bool, Allocator>::back() const noexcept
     return this->operator[](size_ - 1);
 }
 
+template<typename Allocator>
+uint8_t* Vector<bool, Allocator>::data() noexcept
+{
+    return reinterpret_cast<uint8_t*>(allocator_.data());
+}
+
+template<typename Allocator>
+const uint8_t* Vector<bool, Allocator>::data() const noexcept
+{
+    return reinterpret_cast<const uint8_t*>(allocator_.data());
+}
+
 template<typename Allocator>
 void Vector<bool, Allocator>::swap(Vector& other)
 {
@@ -209,6 +254,69 @@ void Vector<bool, Allocator>::swap(Vector& other)
     std::swap(size_, other.size_);
 }
 
+template<typename Allocator>
+StdErrors Vector<bool, Allocator>::tryReserve(size_t newCapacity) noexcept
+{
+    if (newCapacity <= capacity())
+        return StdErrors::Ok;
+
+    Allocator newAllocator;
+
+    StdErrors error = newAllocator.tryRealloc(getNeededSize(newCapacity));
+    if (error != StdErrors::Ok)
+        return error;
+
+    memcpy(newAllocator.data(), allocator_.data(), allocator_.size());
+    newAllocator.size(allocator_.size());
+
+    allocator_.swap(newAllocator);
+
+    return StdErrors::Ok;
+}
+
+template<typename Allocator>
+StdErrors Vector<bool, Allocator>::tryPushBack(const bool value) noexcept
+{
+    if (size_ == capacity())
+    {
+        StdErrors error = tryReserve(getCapacityAfterGrowth(allocator_.capacity()) * __CHAR_BIT__);
+        if (error != StdErrors::Ok)
+            return error;
+    }
+
+    setBit(data(), size_, value);
+
+    ++size_;
+    allocator_.size(getNeededSize(size_));
+
+    return StdErrors::Ok;
+}
+
+template<typename Allocator>
+StdErrors Vector<bool, Allocator>::tryResize(size_t newSize, const bool value) noexcept
+{
+    StdErrors error = tryReserve(newSize);
+    if (error != StdErrors::Ok)
+        return error;
+
+    for (size_t pos = size_; pos < newSize; ++pos)
+        setBit(data(), pos, value);
+
+    size_ = newSize;
+    allocator_.size(getNeededSize(size_));
+
+    return StdErrors::Ok;
+}
+
+template<typename Allocator>
+Expected<bool> Vector<bool, Allocator>::tryAt(size_t pos) const noexcept
+{
+    if (pos >= size_)
+        return StdErrors::VectorIndexOutOfBounds;
+
+    return Expected<bool>{getBit(data(), pos)};
+}
+
 // TODO: need to reimplement everything?? (resize, etc..)
 
 // -----------------------Private--------------------------------
@@ -216,21 +324,21 @@ void Vector<bool, Allocator>::swap(Vector& other)
 template<typename Allocator>
 typename Vector<bool, Allocator>::PushResult Vector<bool, Allocator>::tryPush(const bool value)
 {   
-    if (needToIncreaseSizeInAllocator(allocator_.capacity(), allocator_.size()))
+    if (size_ >= capacity())
         return PushResult::NeedToResize;
 
-    try
+    EXCEPTIONS_TRY
     {
         setBit(reinterpret_cast<uint8_t*>(allocator_.data()), size_, value);
 
-        if (needToIncreaseSizeInAllocator(allocator_.size(), size_))
-            allocator_.size(allocator_.size() + 1);
+        if (getNeededSize(size_ + 1) > allocator_.size())
+            allocator_.size(getNeededSize(size_ + 1));
 
         ++size_;
     }
-    catch (ExceptionWithReason& exception)
+    EXCEPTIONS_CATCH_WITH_REASON(exception)
     {
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorCtorErr,
             "Failed to copy elements while pushing to vector",
             std::move(exception)
@@ -1,6 +1,7 @@
 #ifndef COMMON_VECTOR_FUNCS_HPP
 #define COMMON_VECTOR_FUNCS_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include "VectorClass.hpp"
 #include "Errors.hpp"
@@ -16,6 +17,22 @@ inline size_t getCapacityAfterGrowth(size_t capacity) noexcept
     return capacity * growthFactor + minCapacity;
 }
 
+// Growth capped at maxCapacity. Only an allocator already full at its limit gets a larger request, which it refuses
+inline size_t getCapacityAfterGrowth(size_t capacity, size_t maxCapacity) noexcept
+{
+    if (capacity >= maxCapacity)
+        return getCapacityAfterGrowth(capacity);
+
+    return std::min(getCapacityAfterGrowth(capacity), maxCapacity);
+}
+
+// Position of the highest set bit, value must be non zero
+inline size_t highestBit(size_t value) noexcept
+{
+    return static_cast<size_t>(sizeof(unsigned long long) * __CHAR_BIT__ - 1) -
+           static_cast<size_t>(__builtin_clzll(value));
+}
+
 } // namespace MyStd
 
 #endif // COMMON_VECTOR_FUNCS_HPP
\ No newline at end of file
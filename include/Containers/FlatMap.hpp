@@ -0,0 +1,394 @@
+#ifndef CONTAINERS_FLAT_MAP_HPP
+#define CONTAINERS_FLAT_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Containers/FlatSet.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Sorted map over two columns: keys and values live in separate Vectors, so the binary search walks
+// only keys and never pulls values into cache. Element at index i of values() belongs to keys()[i].
+template<typename K, typename V, typename Compare = std::less<K>,
+         typename KeyAllocator = DynamicAllocator<K>, typename ValueAllocator = DynamicAllocator<V> >
+class FlatMap final
+{
+    Vector<K, KeyAllocator>   keys_;
+    Vector<V, ValueAllocator> values_;
+    Compare less_;
+
+public:
+    explicit FlatMap(const Compare& less = Compare());
+
+    // Same as insertBulk() into an empty map
+    FlatMap(VectorView<const K> keys, VectorView<const V> values, const Compare& less = Compare());
+
+    // Index of the first key not less than key, size() if there is none
+    size_t lowerBound(const K& key) const noexcept;
+
+    // Index of key, size() if it is absent
+    size_t index   (const K& key) const noexcept;
+    bool   contains(const K& key) const noexcept;
+
+    // nullptr if key is absent
+    V*       find(const K& key) noexcept;
+    const V* find(const K& key) const noexcept;
+
+    V&       at(const K& key);
+    const V& at(const K& key) const;
+
+    // Inserts default value if key is absent
+    V& operator[](const K& key);
+
+    const K& keyAt  (size_t pos) const noexcept;
+    V&       valueAt(size_t pos) noexcept;
+    const V& valueAt(size_t pos) const noexcept;
+
+    VectorView<const K> keys  () const noexcept;
+    VectorView<V>       values() noexcept;
+    VectorView<const V> values() const noexcept;
+
+    bool   empty() const noexcept;
+    size_t size () const noexcept;
+
+    void reserve(size_t newCapacity);
+    void clear() noexcept;
+
+    // Returns false and keeps the old value if key is already there
+    bool insert(const K& key, const V& value);
+
+    // Returns false if key was already there and its value got overwritten
+    bool insertOrAssign(const K& key, const V& value);
+
+    // Sorts the batch and merges it with stored pairs in one pass. Batch values overwrite stored ones,
+    // for keys repeated in the batch the last value wins
+    void insertBulk(VectorView<const K> keys, VectorView<const V> values);
+
+    // Returns false if there was no such key
+    bool erase(const K& key);
+
+    void swap(FlatMap& other);
+
+private:
+    void insertAt(size_t pos, const K& key, const V& value);
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::FlatMap(const Compare& less) : keys_(), values_(), less_(less)
+{
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::FlatMap(
+    VectorView<const K> keys, VectorView<const V> values, const Compare& less
+) : keys_(), values_(), less_(less)
+{
+    insertBulk(keys, values);
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+size_t FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::lowerBound(const K& key) const noexcept
+{
+    return flatLowerBound(keys_.data(), keys_.size(), key, less_);
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+size_t FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::index(const K& key) const noexcept
+{
+    size_t pos = lowerBound(key);
+
+    return pos != keys_.size() && !less_(key, keys_[pos]) ? pos : keys_.size();
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+bool FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::contains(const K& key) const noexcept
+{
+    return index(key) != keys_.size();
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+V* FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::find(const K& key) noexcept
+{
+    size_t pos = index(key);
+
+    return pos != keys_.size() ? values_.data() + pos : nullptr;
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+const V* FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::find(const K& key) const noexcept
+{
+    size_t pos = index(key);
+
+    return pos != keys_.size() ? values_.data() + pos : nullptr;
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+V& FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::at(const K& key)
+{
+    return const_cast<V&>(static_cast<const FlatMap&>(*this).at(key));
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+const V& FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::at(const K& key) const
+{
+    const V* value = find(key);
+
+    if (!value)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::KeyNotFound,
+            "Flat map has no such key",
+            {}
+        );
+    }
+
+    return *value;
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+V& FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::operator[](const K& key)
+{
+    size_t pos = lowerBound(key);
+
+    if (pos == keys_.size() || less_(key, keys_[pos]))
+        insertAt(pos, key, V());
+
+    return values_.data()[pos];
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+const K& FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::keyAt(size_t pos) const noexcept
+{
+    return keys_[pos];
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+V& FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::valueAt(size_t pos) noexcept
+{
+    return values_.data()[pos];
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+const V& FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::valueAt(size_t pos) const noexcept
+{
+    return values_.data()[pos];
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+VectorView<const K> FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::keys() const noexcept
+{
+    return VectorView<const K>{keys_};
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+VectorView<V> FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::values() noexcept
+{
+    return VectorView<V>{values_};
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+VectorView<const V> FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::values() const noexcept
+{
+    return VectorView<const V>{values_};
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+bool FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::empty() const noexcept
+{
+    return keys_.empty();
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+size_t FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::size() const noexcept
+{
+    return keys_.size();
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+void FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::reserve(size_t newCapacity)
+{
+    keys_.reserve(newCapacity);
+    values_.reserve(newCapacity);
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+void FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::clear() noexcept
+{
+    keys_.clear();
+    values_.clear();
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+bool FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::insert(const K& key, const V& value)
+{
+    size_t pos = lowerBound(key);
+
+    if (pos != keys_.size() && !less_(key, keys_[pos]))
+        return false;
+
+    insertAt(pos, key, value);
+
+    return true;
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+bool FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::insertOrAssign(const K& key, const V& value)
+{
+    size_t pos = lowerBound(key);
+
+    if (pos != keys_.size() && !less_(key, keys_[pos]))
+    {
+        values_.data()[pos] = value;
+        return false;
+    }
+
+    insertAt(pos, key, value);
+
+    return true;
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+void FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::insertBulk(
+    VectorView<const K> keys, VectorView<const V> values
+)
+{
+    if (keys.size() != values.size())
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorSizeMismatch,
+            "Flat map batch has different number of keys and values",
+            {}
+        );
+    }
+
+    if (keys.empty())
+        return;
+
+    // Only indices are sorted, values are touched once when copied to their final place
+    Vector<size_t> order;
+    order.resizeUninitialized(keys.size());
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        order[i] = i;
+
+    const K* batchKeys = keys.data();
+    std::stable_sort(order.data(), order.data() + order.size(),
+        [&](size_t lhs, size_t rhs) { return less_(batchKeys[lhs], batchKeys[rhs]); }
+    );
+
+    Vector<K, KeyAllocator>   mergedKeys;
+    Vector<V, ValueAllocator> mergedValues;
+    mergedKeys  .reserve(keys_.size() + keys.size());
+    mergedValues.reserve(keys_.size() + keys.size());
+
+    size_t oldPos = 0;
+    const size_t* newPos = order.data();
+    const size_t* newEnd = newPos + order.size();
+
+    while (newPos != newEnd)
+    {
+        // Sort is stable, so the last of equal batch keys is the one given last
+        if (newPos + 1 != newEnd && flatKeysEqual(batchKeys[newPos[0]], batchKeys[newPos[1]], less_))
+        {
+            ++newPos;
+            continue;
+        }
+
+        const K& key = batchKeys[*newPos];
+
+        for (; oldPos != keys_.size() && less_(keys_[oldPos], key); ++oldPos)
+        {
+            mergedKeys  .pushBack(keys_[oldPos]);
+            mergedValues.pushBack(values_[oldPos]);
+        }
+
+        if (oldPos != keys_.size() && !less_(key, keys_[oldPos]))
+            ++oldPos;
+
+        mergedKeys  .pushBack(key);
+        mergedValues.pushBack(values[*newPos++]);
+    }
+
+    for (; oldPos != keys_.size(); ++oldPos)
+    {
+        mergedKeys  .pushBack(keys_[oldPos]);
+        mergedValues.pushBack(values_[oldPos]);
+    }
+
+    keys_  .swap(mergedKeys);
+    values_.swap(mergedValues);
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+bool FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::erase(const K& key)
+{
+    size_t pos = index(key);
+
+    if (pos == keys_.size())
+        return false;
+
+    K* keysData   = keys_.data();
+    V* valuesData = values_.data();
+
+    for (size_t i = pos + 1; i < keys_.size(); ++i)
+    {
+        keysData  [i - 1] = keysData  [i];
+        valuesData[i - 1] = valuesData[i];
+    }
+
+    keys_  .popBack();
+    values_.popBack();
+
+    return true;
+}
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+void FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::swap(FlatMap& other)
+{
+    keys_  .swap(other.keys_);
+    values_.swap(other.values_);
+    std::swap(less_, other.less_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename K, typename V, typename Compare, typename KeyAllocator, typename ValueAllocator>
+void FlatMap<K, V, Compare, KeyAllocator, ValueAllocator>::insertAt(size_t pos, const K& key, const V& value)
+{
+    // key and value may refer into either column. pushBack copes with an argument inside its own column,
+    // the key is copied up front in case it lives in the value column, which grows first
+    K keyCopy{key};
+
+    values_.pushBack(value);
+
+    // Columns must stay the same size, so a failed key push takes its value back
+    try
+    {
+        keys_.pushBack(keyCopy);
+    }
+    catch (...)
+    {
+        values_.popBack();
+        throw;
+    }
+
+    // Arguments are never read again, the pushed copies rotate into place
+    size_t size = keys_.size();
+
+    std::rotate(keys_.data()   + pos, keys_.data()   + size - 1, keys_.data()   + size);
+    std::rotate(values_.data() + pos, values_.data() + size - 1, values_.data() + size);
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_FLAT_MAP_HPP
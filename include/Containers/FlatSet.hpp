@@ -0,0 +1,267 @@
+#ifndef CONTAINERS_FLAT_SET_HPP
+#define CONTAINERS_FLAT_SET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+
+namespace MyStd
+{
+
+// Sorted unique keys in one contiguous Vector. Lookups are binary searches over plain memory,
+// single inserts and erases shift the tail, so fill it with insertBulk() when many keys come at once.
+template<typename K, typename Compare = std::less<K>, typename Allocator = DynamicAllocator<K> >
+class FlatSet final
+{
+    Vector<K, Allocator> keys_;
+    Compare less_;
+
+public:
+    using ConstIterator = typename Vector<K, Allocator>::ConstIterator;
+
+    explicit FlatSet(const Compare& less = Compare());
+
+    // Same as insertBulk() into an empty set
+    explicit FlatSet(VectorView<const K> keys, const Compare& less = Compare());
+
+    // Index of the first key not less than key, size() if there is none
+    size_t lowerBound(const K& key) const noexcept;
+
+    // Index of key, size() if it is absent
+    size_t find    (const K& key) const noexcept;
+    bool   contains(const K& key) const noexcept;
+
+    const K& operator[](size_t pos) const noexcept;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator end  () const noexcept;
+
+    VectorView<const K> keys() const noexcept;
+
+    bool   empty() const noexcept;
+    size_t size () const noexcept;
+
+    void reserve(size_t newCapacity);
+    void clear() noexcept;
+
+    // Returns false if key is already there
+    bool insert(const K& key);
+
+    // Sorts the batch and merges it with stored keys in one pass, O(n + m log m) instead of m shifts
+    void insertBulk(VectorView<const K> keys);
+
+    // Returns false if there was no such key
+    bool erase(const K& key);
+
+    void swap(FlatSet& other);
+};
+
+// --------------------------Implementation-----------------------------------
+
+namespace
+{
+
+// Branchless: the loop runs exactly log2(size) times and the compiler turns the step into a cmov,
+// so there is no mispredicted jump per level. Both possible next probes are prefetched.
+template<typename K, typename Compare>
+size_t flatLowerBound(const K* keys, size_t size, const K& key, const Compare& less) noexcept
+{
+    if (size == 0)
+        return 0;
+
+    const K* base = keys;
+
+    while (size > 1)
+    {
+        size_t half = size / 2;
+
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+
+        base  = less(base[half - 1], key) ? base + half : base;
+        size -= half;
+    }
+
+    return static_cast<size_t>(base - keys) + (less(*base, key) ? 1 : 0);
+}
+
+template<typename K, typename Compare>
+bool flatKeysEqual(const K& lhs, const K& rhs, const Compare& less) noexcept
+{
+    return !less(lhs, rhs) && !less(rhs, lhs);
+}
+
+} // namespace anon
+
+template<typename K, typename Compare, typename Allocator>
+FlatSet<K, Compare, Allocator>::FlatSet(const Compare& less) : keys_(), less_(less)
+{
+}
+
+template<typename K, typename Compare, typename Allocator>
+FlatSet<K, Compare, Allocator>::FlatSet(VectorView<const K> keys, const Compare& less) : keys_(), less_(less)
+{
+    insertBulk(keys);
+}
+
+template<typename K, typename Compare, typename Allocator>
+size_t FlatSet<K, Compare, Allocator>::lowerBound(const K& key) const noexcept
+{
+    return flatLowerBound(keys_.data(), keys_.size(), key, less_);
+}
+
+template<typename K, typename Compare, typename Allocator>
+size_t FlatSet<K, Compare, Allocator>::find(const K& key) const noexcept
+{
+    size_t pos = lowerBound(key);
+
+    return pos != keys_.size() && !less_(key, keys_[pos]) ? pos : keys_.size();
+}
+
+template<typename K, typename Compare, typename Allocator>
+bool FlatSet<K, Compare, Allocator>::contains(const K& key) const noexcept
+{
+    return find(key) != keys_.size();
+}
+
+template<typename K, typename Compare, typename Allocator>
+const K& FlatSet<K, Compare, Allocator>::operator[](size_t pos) const noexcept
+{
+    return keys_[pos];
+}
+
+template<typename K, typename Compare, typename Allocator>
+typename FlatSet<K, Compare, Allocator>::ConstIterator FlatSet<K, Compare, Allocator>::begin() const noexcept
+{
+    return keys_.begin();
+}
+
+template<typename K, typename Compare, typename Allocator>
+typename FlatSet<K, Compare, Allocator>::ConstIterator FlatSet<K, Compare, Allocator>::end() const noexcept
+{
+    return keys_.end();
+}
+
+template<typename K, typename Compare, typename Allocator>
+VectorView<const K> FlatSet<K, Compare, Allocator>::keys() const noexcept
+{
+    return VectorView<const K>{keys_};
+}
+
+template<typename K, typename Compare, typename Allocator>
+bool FlatSet<K, Compare, Allocator>::empty() const noexcept
+{
+    return keys_.empty();
+}
+
+template<typename K, typename Compare, typename Allocator>
+size_t FlatSet<K, Compare, Allocator>::size() const noexcept
+{
+    return keys_.size();
+}
+
+template<typename K, typename Compare, typename Allocator>
+void FlatSet<K, Compare, Allocator>::reserve(size_t newCapacity)
+{
+    keys_.reserve(newCapacity);
+}
+
+template<typename K, typename Compare, typename Allocator>
+void FlatSet<K, Compare, Allocator>::clear() noexcept
+{
+    keys_.clear();
+}
+
+template<typename K, typename Compare, typename Allocator>
+bool FlatSet<K, Compare, Allocator>::insert(const K& key)
+{
+    size_t pos = lowerBound(key);
+
+    if (pos != keys_.size() && !less_(key, keys_[pos]))
+        return false;
+
+    // key may refer into the set, so it is not read again: the pushed copy rotates into place
+    keys_.pushBack(key);
+
+    size_t size = keys_.size();
+    std::rotate(keys_.data() + pos, keys_.data() + size - 1, keys_.data() + size);
+
+    return true;
+}
+
+template<typename K, typename Compare, typename Allocator>
+void FlatSet<K, Compare, Allocator>::insertBulk(VectorView<const K> keys)
+{
+    if (keys.empty())
+        return;
+
+    Vector<K> batch;
+    batch.reserve(keys.size());
+
+    for (const K& key : keys)
+        batch.pushBack(key);
+
+    std::sort(batch.data(), batch.data() + batch.size(), less_);
+
+    Vector<K, Allocator> merged;
+    merged.reserve(keys_.size() + batch.size());
+
+    const K* oldPos = keys_.data();
+    const K* oldEnd = oldPos + keys_.size();
+    const K* newPos = batch.data();
+    const K* newEnd = newPos + batch.size();
+
+    while (newPos != newEnd)
+    {
+        // Duplicates inside the batch are adjacent after sorting
+        if (newPos + 1 != newEnd && flatKeysEqual(newPos[0], newPos[1], less_))
+        {
+            ++newPos;
+            continue;
+        }
+
+        while (oldPos != oldEnd && less_(*oldPos, *newPos))
+            merged.pushBack(*oldPos++);
+
+        if (oldPos != oldEnd && !less_(*newPos, *oldPos))
+            ++oldPos;
+
+        merged.pushBack(*newPos++);
+    }
+
+    while (oldPos != oldEnd)
+        merged.pushBack(*oldPos++);
+
+    keys_.swap(merged);
+}
+
+template<typename K, typename Compare, typename Allocator>
+bool FlatSet<K, Compare, Allocator>::erase(const K& key)
+{
+    size_t pos = find(key);
+
+    if (pos == keys_.size())
+        return false;
+
+    K* keys = keys_.data();
+    for (size_t i = pos + 1; i < keys_.size(); ++i)
+        keys[i - 1] = keys[i];
+
+    keys_.popBack();
+
+    return true;
+}
+
+template<typename K, typename Compare, typename Allocator>
+void FlatSet<K, Compare, Allocator>::swap(FlatSet& other)
+{
+    keys_.swap(other.keys_);
+    std::swap(less_, other.less_);
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_FLAT_SET_HPP
@@ -0,0 +1,450 @@
+#ifndef CONTAINERS_HASH_MAP_HPP
+#define CONTAINERS_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+#include "Vector.hpp"
+#include "CommonVectorFuncs.hpp"
+#include "Containers/SoaVector.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Open addressing with linear probing. Slots are three parallel columns of capacity() entries: keys,
+// values and two bitmaps (occupied and tombstone) in Vector<bool>, so a probe over empty slots reads
+// bits, not keys. Columns::Allocator<Field> picks the backend, same policies as SoaVector.
+// Keys and values must be default constructible, free slots hold default constructed ones.
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+         typename Columns = DynamicColumns>
+class HashMap final
+{
+    using KeyColumn   = Vector<K,    typename Columns::template Allocator<K> >;
+    using ValueColumn = Vector<V,    typename Columns::template Allocator<V> >;
+    using BitColumn   = Vector<bool, typename Columns::template Allocator<bool> >;
+
+    static constexpr size_t minCapacity = 16;
+
+    KeyColumn   keys_;
+    ValueColumn values_;
+    BitColumn   occupied_;
+    BitColumn   tombstones_;
+
+    size_t size_;
+    size_t tombstonesCount_;
+    size_t shift_; // slot of hash h is mixed(h) >> shift_, capacity is 2^(64 - shift_)
+
+    Hash hash_;
+    KeyEqual equal_;
+
+public:
+    explicit HashMap(const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+
+    // nullptr if key is absent
+    V*       find(const K& key) noexcept;
+    const V* find(const K& key) const noexcept;
+
+    bool contains(const K& key) const noexcept;
+
+    V&       at(const K& key);
+    const V& at(const K& key) const;
+
+    // Inserts default value if key is absent
+    V& operator[](const K& key);
+
+    // Returns false and keeps the old value if key is already there
+    bool insert(const K& key, const V& value);
+
+    // Returns false if key was already there and its value got overwritten
+    bool insertOrAssign(const K& key, const V& value);
+
+    // Leaves a tombstone, slots are reclaimed by the next insert on the same chain or by rehash
+    bool erase(const K& key);
+
+    bool   empty   () const noexcept;
+    size_t size    () const noexcept;
+    size_t capacity() const noexcept;
+
+    // Rehashes once so that count elements fit without another rehash
+    void reserve(size_t count);
+    void clear() noexcept;
+
+    // Calls func(const K& key, V& value) for every element, in slot order
+    template<typename Func>
+    void forEach(Func func);
+
+    template<typename Func>
+    void forEach(Func func) const;
+
+    void swap(HashMap& other);
+
+private:
+    size_t slotOf(const K& key) const noexcept;
+    size_t nextSlot(size_t slot) const noexcept;
+
+    // Slot holding key, capacity() if it is absent
+    size_t findSlot(const K& key) const noexcept;
+
+    // Slot for a new key: first tombstone or empty slot on its chain. Only when key is absent
+    size_t freeSlot(const K& key) const noexcept;
+
+    // Returns slot of key, true if it was inserted
+    std::pair<size_t, bool> insertSlot(const K& key, const V& value);
+
+    // Stores absent key with its value, no growth
+    std::pair<size_t, bool> occupySlot(const K& key, const V& value);
+
+    bool needsGrowth() const noexcept;
+    void grow();
+    void rehash(size_t newCapacity);
+
+    static size_t capacityFor(size_t count) noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+HashMap<K, V, Hash, KeyEqual, Columns>::HashMap(const Hash& hash, const KeyEqual& equal) :
+    keys_(), values_(), occupied_(), tombstones_(), size_(0), tombstonesCount_(0), shift_(64),
+    hash_(hash), equal_(equal)
+{
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+V* HashMap<K, V, Hash, KeyEqual, Columns>::find(const K& key) noexcept
+{
+    size_t slot = findSlot(key);
+
+    return slot != capacity() ? values_.data() + slot : nullptr;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+const V* HashMap<K, V, Hash, KeyEqual, Columns>::find(const K& key) const noexcept
+{
+    size_t slot = findSlot(key);
+
+    return slot != capacity() ? values_.data() + slot : nullptr;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+bool HashMap<K, V, Hash, KeyEqual, Columns>::contains(const K& key) const noexcept
+{
+    return findSlot(key) != capacity();
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+V& HashMap<K, V, Hash, KeyEqual, Columns>::at(const K& key)
+{
+    return const_cast<V&>(static_cast<const HashMap&>(*this).at(key));
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+const V& HashMap<K, V, Hash, KeyEqual, Columns>::at(const K& key) const
+{
+    const V* value = find(key);
+
+    if (!value)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::KeyNotFound,
+            "Hash map has no such key",
+            {}
+        );
+    }
+
+    return *value;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+V& HashMap<K, V, Hash, KeyEqual, Columns>::operator[](const K& key)
+{
+    // Insertion may rehash, so the slot is taken before data()
+    size_t slot = insertSlot(key, V()).first;
+
+    return values_.data()[slot];
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+bool HashMap<K, V, Hash, KeyEqual, Columns>::insert(const K& key, const V& value)
+{
+    return insertSlot(key, value).second;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+bool HashMap<K, V, Hash, KeyEqual, Columns>::insertOrAssign(const K& key, const V& value)
+{
+    std::pair<size_t, bool> result = insertSlot(key, value);
+
+    if (!result.second)
+        values_.data()[result.first] = value;
+
+    return result.second;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+bool HashMap<K, V, Hash, KeyEqual, Columns>::erase(const K& key)
+{
+    size_t slot = findSlot(key);
+
+    if (slot == capacity())
+        return false;
+
+    setBit(occupied_.data(),   slot, false);
+    setBit(tombstones_.data(), slot, true);
+
+    keys_  .data()[slot] = K();
+    values_.data()[slot] = V();
+
+    --size_;
+    ++tombstonesCount_;
+
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+bool HashMap<K, V, Hash, KeyEqual, Columns>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::capacity() const noexcept
+{
+    return keys_.size();
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+void HashMap<K, V, Hash, KeyEqual, Columns>::reserve(size_t count)
+{
+    size_t newCapacity = capacityFor(count);
+
+    if (newCapacity > capacity())
+        rehash(newCapacity);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+void HashMap<K, V, Hash, KeyEqual, Columns>::clear() noexcept
+{
+    for (size_t slot = 0; slot < capacity(); ++slot)
+    {
+        keys_  .data()[slot] = K();
+        values_.data()[slot] = V();
+    }
+
+    memset(occupied_  .data(), 0, getNeededSize(capacity()));
+    memset(tombstones_.data(), 0, getNeededSize(capacity()));
+
+    size_            = 0;
+    tombstonesCount_ = 0;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+template<typename Func>
+void HashMap<K, V, Hash, KeyEqual, Columns>::forEach(Func func)
+{
+    const uint8_t* occupied = occupied_.data();
+
+    for (size_t block = 0; block < getNeededSize(capacity()); ++block)
+    {
+        // Whole empty bytes are skipped, 8 slots per check
+        for (unsigned bits = occupied[block]; bits != 0; bits &= bits - 1)
+        {
+            size_t slot = block * __CHAR_BIT__ + static_cast<size_t>(__builtin_ctz(bits));
+            func(static_cast<const K&>(keys_.data()[slot]), values_.data()[slot]);
+        }
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+template<typename Func>
+void HashMap<K, V, Hash, KeyEqual, Columns>::forEach(Func func) const
+{
+    const uint8_t* occupied = occupied_.data();
+
+    for (size_t block = 0; block < getNeededSize(capacity()); ++block)
+    {
+        for (unsigned bits = occupied[block]; bits != 0; bits &= bits - 1)
+        {
+            size_t slot = block * __CHAR_BIT__ + static_cast<size_t>(__builtin_ctz(bits));
+            func(keys_.data()[slot], values_.data()[slot]);
+        }
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+void HashMap<K, V, Hash, KeyEqual, Columns>::swap(HashMap& other)
+{
+    keys_      .swap(other.keys_);
+    values_    .swap(other.values_);
+    occupied_  .swap(other.occupied_);
+    tombstones_.swap(other.tombstones_);
+
+    std::swap(size_,            other.size_);
+    std::swap(tombstonesCount_, other.tombstonesCount_);
+    std::swap(shift_,           other.shift_);
+    std::swap(hash_,            other.hash_);
+    std::swap(equal_,           other.equal_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::slotOf(const K& key) const noexcept
+{
+    // Fibonacci hashing: takes the top bits, so weak hashes like identity for integers still spread out
+    uint64_t mixed = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+
+    return static_cast<size_t>(mixed >> shift_);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::nextSlot(size_t slot) const noexcept
+{
+    return (slot + 1) & (capacity() - 1);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::findSlot(const K& key) const noexcept
+{
+    if (size_ == 0)
+        return capacity();
+
+    const uint8_t* occupied   = occupied_.data();
+    const uint8_t* tombstones = tombstones_.data();
+
+    // Load factor keeps at least one empty slot, so the chain always ends
+    for (size_t slot = slotOf(key);; slot = nextSlot(slot))
+    {
+        if (getBit(occupied, slot))
+        {
+            if (equal_(keys_.data()[slot], key))
+                return slot;
+        }
+        else if (!getBit(tombstones, slot))
+        {
+            return capacity();
+        }
+    }
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::freeSlot(const K& key) const noexcept
+{
+    const uint8_t* occupied = occupied_.data();
+
+    size_t slot = slotOf(key);
+    while (getBit(occupied, slot))
+        slot = nextSlot(slot);
+
+    return slot;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+std::pair<size_t, bool> HashMap<K, V, Hash, KeyEqual, Columns>::insertSlot(const K& key, const V& value)
+{
+    size_t slot = findSlot(key);
+
+    if (slot != capacity())
+        return {slot, false};
+
+    if (!needsGrowth())
+        return occupySlot(key, value);
+
+    // key and value may refer into the columns that rehash frees, so copies are what gets inserted
+    K keyCopy  {key};
+    V valueCopy{value};
+
+    grow();
+
+    return occupySlot(keyCopy, valueCopy);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+std::pair<size_t, bool> HashMap<K, V, Hash, KeyEqual, Columns>::occupySlot(const K& key, const V& value)
+{
+    size_t slot = freeSlot(key);
+
+    keys_  .data()[slot] = key;
+    values_.data()[slot] = value;
+
+    if (getBit(tombstones_.data(), slot))
+    {
+        setBit(tombstones_.data(), slot, false);
+        --tombstonesCount_;
+    }
+
+    setBit(occupied_.data(), slot, true);
+    ++size_;
+
+    return {slot, true};
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+bool HashMap<K, V, Hash, KeyEqual, Columns>::needsGrowth() const noexcept
+{
+    // Tombstones lengthen chains just like elements, so they count towards the 3/4 load factor
+    return (size_ + tombstonesCount_ + 1) * 4 > capacity() * 3;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+void HashMap<K, V, Hash, KeyEqual, Columns>::grow()
+{
+    // Mostly tombstones: rehash in place of growing
+    rehash(std::max(capacityFor(size_ + 1), capacity()));
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+void HashMap<K, V, Hash, KeyEqual, Columns>::rehash(size_t newCapacity)
+{
+    HashMap rehashed{hash_, equal_};
+
+    rehashed.keys_      .resize(newCapacity);
+    rehashed.values_    .resize(newCapacity);
+    rehashed.shift_ = 64 - highestBit(newCapacity);
+
+    BitColumn occupied  {newCapacity, false};
+    BitColumn tombstones{newCapacity, false};
+    rehashed.occupied_  .swap(occupied);
+    rehashed.tombstones_.swap(tombstones);
+
+    // Keys are known to be unique, so relocation skips the lookups and just takes the first free slot
+    forEach([&](const K& key, const V& value)
+    {
+        size_t slot = rehashed.freeSlot(key);
+
+        rehashed.keys_  .data()[slot] = key;
+        rehashed.values_.data()[slot] = value;
+        setBit(rehashed.occupied_.data(), slot, true);
+    });
+
+    rehashed.size_ = size_;
+
+    swap(rehashed);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Columns>
+size_t HashMap<K, V, Hash, KeyEqual, Columns>::capacityFor(size_t count) noexcept
+{
+    size_t capacity = minCapacity;
+
+    while (count * 4 > capacity * 3)
+        capacity *= 2;
+
+    return capacity;
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_HASH_MAP_HPP
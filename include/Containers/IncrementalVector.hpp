@@ -0,0 +1,417 @@
+#ifndef CONTAINERS_INCREMENTAL_VECTOR_HPP
+#define CONTAINERS_INCREMENTAL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "CommonVectorFuncs.hpp"
+#include "Allocators/Allocator.hpp"
+#include "Allocators/DynamicAllocator.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Vector whose growth never copies everything at once. When the buffer is full a bigger one is allocated
+// and every following pushBack/popBack moves at most migrationStep old elements into it, like incremental
+// rehashing. While migration is in progress elements [migrated, oldSize) are still read from the old buffer.
+// Buffer capacity at least doubles, so migration always ends before the next growth.
+//
+// It is a separate container rather than a Vector mode: Vector promises one contiguous data() that views,
+// simd kernels and snapshots rely on, and a two-buffer state would put a branch into every Vector access.
+template<typename T, typename Allocator = DynamicAllocator<T>, size_t migrationStep = 4>
+class IncrementalVector final
+{
+    static_assert(migrationStep >= 2, "migration must outpace growth");
+
+    Allocator allocator_;    // current buffer, holds [0, migrated_) and [oldSize_, size_)
+    Allocator oldAllocator_; // buffer being drained, holds [migrated_, oldSize_)
+
+    size_t size_;
+    size_t oldSize_;
+    size_t migrated_;
+
+public:
+    template<typename Container, typename Value>
+    class IteratorBase final
+    {
+        Container* vector_;
+        size_t pos_;
+
+    public:
+        IteratorBase(Container* vector, size_t pos) noexcept : vector_(vector), pos_(pos) {}
+
+        IteratorBase& operator++() noexcept { ++pos_; return *this; }
+
+        Value& operator* () const noexcept { return (*vector_)[pos_]; }
+        Value* operator->() const noexcept { return &(*vector_)[pos_]; }
+
+        bool operator==(const IteratorBase& other) const noexcept { return pos_ == other.pos_; }
+        bool operator!=(const IteratorBase& other) const noexcept { return pos_ != other.pos_; }
+    };
+
+    using Iterator      = IteratorBase<IncrementalVector, T>;
+    using ConstIterator = IteratorBase<const IncrementalVector, const T>;
+
+    IncrementalVector();
+    IncrementalVector(const IncrementalVector& other) = delete;
+    IncrementalVector(IncrementalVector&& other);
+
+    IncrementalVector& operator=(const IncrementalVector& other) = delete;
+    IncrementalVector& operator=(IncrementalVector&& other);
+
+    ~IncrementalVector();
+
+    T&       at(size_t pos);
+    const T& at(size_t pos) const;
+
+    T&       operator[](size_t pos) noexcept;
+    const T& operator[](size_t pos) const noexcept;
+
+    T&       back() noexcept;
+    const T& back() const noexcept;
+
+    Iterator begin() noexcept;
+    Iterator end  () noexcept;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator end  () const noexcept;
+
+    bool   empty   () const noexcept;
+    size_t size    () const noexcept;
+    size_t capacity() const noexcept;
+
+    bool isMigrating() const noexcept;
+
+    // Unbounded: drains the old buffer completely
+    void finishMigration();
+
+    // Unbounded: finishes migration and reallocates at once
+    void reserve(size_t newCapacity);
+
+    // Copies at most migrationStep + 1 elements
+    void pushBack(const T& value);
+    void popBack();
+
+    void clear() noexcept;
+
+    // Migration state travels with the buffers
+    void swap(IncrementalVector& other);
+
+private:
+    void migrate(size_t count);
+    void startMigration();
+    void releaseOldBuffer() noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator, size_t migrationStep>
+IncrementalVector<T, Allocator, migrationStep>::IncrementalVector() :
+    allocator_(), oldAllocator_(), size_(0), oldSize_(0), migrated_(0)
+{
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+IncrementalVector<T, Allocator, migrationStep>::IncrementalVector(IncrementalVector&& other) : IncrementalVector()
+{
+    swap(other);
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+IncrementalVector<T, Allocator, migrationStep>&
+    IncrementalVector<T, Allocator, migrationStep>::operator=(IncrementalVector&& other)
+{
+    IncrementalVector tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+IncrementalVector<T, Allocator, migrationStep>::~IncrementalVector()
+{
+    clear();
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+T& IncrementalVector<T, Allocator, migrationStep>::at(size_t pos)
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Incremental vector index out of bounds",
+            {}
+        );
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+const T& IncrementalVector<T, Allocator, migrationStep>::at(size_t pos) const
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Incremental vector index out of bounds",
+            {}
+        );
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+T& IncrementalVector<T, Allocator, migrationStep>::operator[](size_t pos) noexcept
+{
+    if (pos >= migrated_ && pos < oldSize_)
+        return oldAllocator_.data()[pos];
+
+    return allocator_.data()[pos];
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+const T& IncrementalVector<T, Allocator, migrationStep>::operator[](size_t pos) const noexcept
+{
+    if (pos >= migrated_ && pos < oldSize_)
+        return oldAllocator_.data()[pos];
+
+    return allocator_.data()[pos];
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+T& IncrementalVector<T, Allocator, migrationStep>::back() noexcept
+{
+    return (*this)[size_ - 1];
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+const T& IncrementalVector<T, Allocator, migrationStep>::back() const noexcept
+{
+    return (*this)[size_ - 1];
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+typename IncrementalVector<T, Allocator, migrationStep>::Iterator
+    IncrementalVector<T, Allocator, migrationStep>::begin() noexcept
+{
+    return Iterator{this, 0};
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+typename IncrementalVector<T, Allocator, migrationStep>::Iterator
+    IncrementalVector<T, Allocator, migrationStep>::end() noexcept
+{
+    return Iterator{this, size_};
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+typename IncrementalVector<T, Allocator, migrationStep>::ConstIterator
+    IncrementalVector<T, Allocator, migrationStep>::begin() const noexcept
+{
+    return ConstIterator{this, 0};
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+typename IncrementalVector<T, Allocator, migrationStep>::ConstIterator
+    IncrementalVector<T, Allocator, migrationStep>::end() const noexcept
+{
+    return ConstIterator{this, size_};
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+bool IncrementalVector<T, Allocator, migrationStep>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+size_t IncrementalVector<T, Allocator, migrationStep>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+size_t IncrementalVector<T, Allocator, migrationStep>::capacity() const noexcept
+{
+    return allocator_.capacity();
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+bool IncrementalVector<T, Allocator, migrationStep>::isMigrating() const noexcept
+{
+    return migrated_ < oldSize_;
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::finishMigration()
+{
+    migrate(oldSize_ - migrated_);
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::reserve(size_t newCapacity)
+{
+    if (newCapacity <= allocator_.capacity())
+        return;
+
+    finishMigration();
+    allocator_.realloc(newCapacity);
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::pushBack(const T& value)
+{
+    if (size_ == allocator_.capacity())
+        startMigration();
+
+    try
+    {
+        constructInMemory(allocator_.data() + size_, value);
+    }
+    catch (ExceptionWithReason& exception)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorCtorErr,
+            "Failed to copy element while pushing to incremental vector",
+            std::move(exception)
+        );
+    }
+
+    ++size_;
+    allocator_.size(allocator_.size() + 1);
+
+    migrate(migrationStep);
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::popBack()
+{
+    size_t pos = size_ - 1;
+
+    if (pos >= oldSize_ || pos < migrated_)
+    {
+        allocator_.data()[pos].~T();
+        allocator_.size(allocator_.size() - 1);
+    }
+    else
+    {
+        // Last element is still in the old buffer, so nothing after it was pushed since the growth
+        oldAllocator_.data()[pos].~T();
+        oldAllocator_.size(oldAllocator_.size() - 1);
+        --oldSize_;
+    }
+
+    --size_;
+
+    if (isMigrating())
+        migrate(migrationStep);
+    else
+        releaseOldBuffer();
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::clear() noexcept
+{
+    T* data = allocator_.data();
+    for (size_t pos = 0; pos < size_; ++pos)
+    {
+        if (pos >= migrated_ && pos < oldSize_)
+            oldAllocator_.data()[pos].~T();
+        else
+            data[pos].~T();
+    }
+
+    allocator_.size(0);
+    oldAllocator_.size(0);
+
+    size_     = 0;
+    oldSize_  = 0;
+    migrated_ = 0;
+
+    releaseOldBuffer();
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::swap(IncrementalVector& other)
+{
+    allocator_.swap(other.allocator_);
+    oldAllocator_.swap(other.oldAllocator_);
+
+    std::swap(size_,     other.size_);
+    std::swap(oldSize_,  other.oldSize_);
+    std::swap(migrated_, other.migrated_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::migrate(size_t count)
+{
+    size_t migrateTo = std::min(oldSize_, migrated_ + count);
+
+    T* oldData = oldAllocator_.data();
+    T* newData = allocator_.data();
+
+    for (; migrated_ < migrateTo; ++migrated_)
+    {
+        try
+        {
+            constructInMemory(newData + migrated_, oldData[migrated_]);
+        }
+        catch (ExceptionWithReason& exception)
+        {
+            throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                StdErrors::VectorCtorErr,
+                "Failed to migrate element in incremental vector",
+                std::move(exception)
+            );
+        }
+
+        oldData[migrated_].~T();
+        oldAllocator_.size(oldAllocator_.size() - 1);
+        allocator_.size(allocator_.size() + 1);
+    }
+
+    if (!isMigrating())
+        releaseOldBuffer();
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::startMigration()
+{
+    // Capacity at least doubles and every operation migrates two or more elements, so this is a no-op
+    // unless finishMigration was skipped by an exception
+    finishMigration();
+
+    Allocator newAllocator{getCapacityAfterGrowth(allocator_.capacity())};
+
+    oldAllocator_.swap(allocator_);
+    allocator_.swap(newAllocator);
+
+    oldSize_  = size_;
+    migrated_ = 0;
+}
+
+template<typename T, typename Allocator, size_t migrationStep>
+void IncrementalVector<T, Allocator, migrationStep>::releaseOldBuffer() noexcept
+{
+    // Everything lives in the current buffer now: [0, 0) and [0, size_)
+    oldSize_  = 0;
+    migrated_ = 0;
+
+    if (oldAllocator_.capacity() == 0)
+        return;
+
+    Allocator empty;
+    oldAllocator_.swap(empty);
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_INCREMENTAL_VECTOR_HPP
@@ -0,0 +1,297 @@
+#ifndef CONTAINERS_JAGGED_VECTOR_HPP
+#define CONTAINERS_JAGGED_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "CommonVectorFuncs.hpp"
+#include "Parallel/ChunkPartition.hpp"
+#include "Parallel/ThreadPool.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Rows of different lengths in compressed sparse row layout: every value lives in one Vector, row i is
+// values[offsets[i], offsets[i + 1]). Two allocations for the whole container instead of one per row,
+// and traversals walk plain memory. Rows can only be appended, the last one may keep growing
+template<typename T, typename Allocator = DynamicAllocator<T> >
+class JaggedVector final
+{
+    Vector<T, Allocator> values_;
+    Vector<size_t> offsets_;
+
+public:
+    JaggedVector();
+
+    // Copies rows with two exact allocations
+    template<typename RowAllocator, typename RowsAllocator>
+    explicit JaggedVector(const Vector<Vector<T, RowAllocator>, RowsAllocator>& rows);
+
+    VectorView<T>       row(size_t rowId) noexcept;
+    VectorView<const T> row(size_t rowId) const noexcept;
+
+    VectorView<T>       at(size_t rowId);
+    VectorView<const T> at(size_t rowId) const;
+
+    size_t rowSize(size_t rowId) const noexcept;
+
+    // All rows back to back and rowsCount() + 1 row boundaries, for code that works on raw CSR
+    VectorView<T>            values() noexcept;
+    VectorView<const T>      values() const noexcept;
+    VectorView<const size_t> offsets() const noexcept;
+
+    bool   empty      () const noexcept;
+    size_t rowsCount  () const noexcept;
+    size_t valuesCount() const noexcept;
+
+    void reserve(size_t rowsCapacity, size_t valuesCapacity);
+    void clear() noexcept;
+
+    // row may be a view into this container
+    void appendRow(VectorView<const T> row);
+
+    // Adds value to the end of the last row, there must be one
+    void appendToLastRow(const T& value);
+
+    void swap(JaggedVector& other);
+};
+
+// Chunks hold about the same number of values, not of rows, so a few long rows don't load one thread.
+// func(rowId, row) sees every row exactly once
+template<typename T, typename Allocator, typename Func>
+void parallelForEachRow(JaggedVector<T, Allocator>& jagged, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEachRow(
+    const JaggedVector<T, Allocator>& jagged, Func func, ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator>
+JaggedVector<T, Allocator>::JaggedVector() : values_(), offsets_(1, 0)
+{
+}
+
+template<typename T, typename Allocator>
+template<typename RowAllocator, typename RowsAllocator>
+JaggedVector<T, Allocator>::JaggedVector(const Vector<Vector<T, RowAllocator>, RowsAllocator>& rows) :
+    values_(), offsets_()
+{
+    size_t valuesCount = 0;
+    for (size_t rowId = 0; rowId < rows.size(); ++rowId)
+        valuesCount += rows[rowId].size();
+
+    values_.reserve(valuesCount);
+    offsets_.reserve(rows.size() + 1);
+
+    offsets_.pushBack(0);
+    for (size_t rowId = 0; rowId < rows.size(); ++rowId)
+    {
+        const Vector<T, RowAllocator>& row = rows[rowId];
+
+        for (size_t pos = 0; pos < row.size(); ++pos)
+            values_.pushBack(row[pos]);
+
+        offsets_.pushBack(values_.size());
+    }
+}
+
+template<typename T, typename Allocator>
+VectorView<T> JaggedVector<T, Allocator>::row(size_t rowId) noexcept
+{
+    return VectorView<T>{values_.data() + offsets_[rowId], offsets_[rowId + 1] - offsets_[rowId]};
+}
+
+template<typename T, typename Allocator>
+VectorView<const T> JaggedVector<T, Allocator>::row(size_t rowId) const noexcept
+{
+    return VectorView<const T>{values_.data() + offsets_[rowId], offsets_[rowId + 1] - offsets_[rowId]};
+}
+
+template<typename T, typename Allocator>
+VectorView<T> JaggedVector<T, Allocator>::at(size_t rowId)
+{
+    if (rowId >= rowsCount())
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds, "Row index is out of bounds in jagged vector", {}
+        );
+    }
+
+    return row(rowId);
+}
+
+template<typename T, typename Allocator>
+VectorView<const T> JaggedVector<T, Allocator>::at(size_t rowId) const
+{
+    if (rowId >= rowsCount())
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds, "Row index is out of bounds in jagged vector", {}
+        );
+    }
+
+    return row(rowId);
+}
+
+template<typename T, typename Allocator>
+size_t JaggedVector<T, Allocator>::rowSize(size_t rowId) const noexcept
+{
+    return offsets_[rowId + 1] - offsets_[rowId];
+}
+
+template<typename T, typename Allocator>
+VectorView<T> JaggedVector<T, Allocator>::values() noexcept
+{
+    return VectorView<T>{values_};
+}
+
+template<typename T, typename Allocator>
+VectorView<const T> JaggedVector<T, Allocator>::values() const noexcept
+{
+    return VectorView<const T>{values_};
+}
+
+template<typename T, typename Allocator>
+VectorView<const size_t> JaggedVector<T, Allocator>::offsets() const noexcept
+{
+    return VectorView<const size_t>{offsets_};
+}
+
+template<typename T, typename Allocator>
+bool JaggedVector<T, Allocator>::empty() const noexcept
+{
+    return rowsCount() == 0;
+}
+
+template<typename T, typename Allocator>
+size_t JaggedVector<T, Allocator>::rowsCount() const noexcept
+{
+    return offsets_.size() - 1;
+}
+
+template<typename T, typename Allocator>
+size_t JaggedVector<T, Allocator>::valuesCount() const noexcept
+{
+    return values_.size();
+}
+
+template<typename T, typename Allocator>
+void JaggedVector<T, Allocator>::reserve(size_t rowsCapacity, size_t valuesCapacity)
+{
+    offsets_.reserve(rowsCapacity + 1);
+    values_.reserve(valuesCapacity);
+}
+
+template<typename T, typename Allocator>
+void JaggedVector<T, Allocator>::clear() noexcept
+{
+    values_.clear();
+
+    while (offsets_.size() > 1)
+        offsets_.popBack();
+}
+
+template<typename T, typename Allocator>
+void JaggedVector<T, Allocator>::appendRow(VectorView<const T> row)
+{
+    size_t oldSize = values_.size();
+    size_t newSize = oldSize + row.size();
+
+    // Position of a row inside our values survives the reallocation, its pointer doesn't
+    const T* base = values_.data();
+    bool ownRow = !std::less<const T*>{}(row.data(), base) && std::less<const T*>{}(row.data(), base + oldSize);
+    size_t rowBegin = ownRow ? static_cast<size_t>(row.data() - base) : 0;
+
+    offsets_.pushBack(newSize);
+
+    // Both buffers must describe the same rows, so a failed copy takes the whole row back
+    try
+    {
+        if (newSize > values_.capacity())
+            values_.reserve(std::max(newSize, getCapacityAfterGrowth(values_.capacity())));
+
+        const T* source = ownRow ? values_.data() + rowBegin : row.data();
+        for (size_t pos = 0; pos < row.size(); ++pos)
+            values_.pushBack(source[pos]);
+    }
+    catch (...)
+    {
+        while (values_.size() > oldSize)
+            values_.popBack();
+
+        offsets_.popBack();
+        throw;
+    }
+}
+
+template<typename T, typename Allocator>
+void JaggedVector<T, Allocator>::appendToLastRow(const T& value)
+{
+    values_.pushBack(value);
+    offsets_[rowsCount()] += 1;
+}
+
+template<typename T, typename Allocator>
+void JaggedVector<T, Allocator>::swap(JaggedVector& other)
+{
+    values_.swap(other.values_);
+    offsets_.swap(other.offsets_);
+}
+
+namespace
+{
+
+// Rows starting in the values of a chunk belong to it, the last chunk also takes trailing empty rows
+template<typename RowFunc>
+void forEachRowChunk(VectorView<const size_t> offsets, size_t valuesCount, RowFunc rowFunc, ThreadPool& pool)
+{
+    size_t rowsCount = offsets.size() - 1;
+    ChunkPartition partition{valuesCount, pool.threadsCount(), 1};
+
+    const size_t* rowStarts = offsets.data();
+    auto firstRowFrom = [&](size_t valuePos)
+    {
+        return static_cast<size_t>(std::lower_bound(rowStarts, rowStarts + rowsCount, valuePos) - rowStarts);
+    };
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        size_t beginRow = chunkId == 0 ? 0 : firstRowFrom(partition.begin(chunkId));
+        size_t endRow   = chunkId + 1 == partition.chunksCount() ? rowsCount : firstRowFrom(partition.end(chunkId));
+
+        for (size_t rowId = beginRow; rowId < endRow; ++rowId)
+            rowFunc(rowId);
+    });
+}
+
+} // namespace anon
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEachRow(JaggedVector<T, Allocator>& jagged, Func func, ThreadPool& pool)
+{
+    forEachRowChunk(jagged.offsets(), jagged.valuesCount(), [&](size_t rowId)
+    {
+        func(rowId, jagged.row(rowId));
+    }, pool);
+}
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEachRow(const JaggedVector<T, Allocator>& jagged, Func func, ThreadPool& pool)
+{
+    forEachRowChunk(jagged.offsets(), jagged.valuesCount(), [&](size_t rowId)
+    {
+        func(rowId, jagged.row(rowId));
+    }, pool);
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_JAGGED_VECTOR_HPP
@@ -0,0 +1,334 @@
+#ifndef CONTAINERS_PACKED_INT_VECTOR_HPP
+#define CONTAINERS_PACKED_INT_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Simd/SimdKernels.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Width policies: Width::bits() is the number of bits taken by one value, 1 to 32
+
+template<unsigned Bits>
+struct FixedBitWidth
+{
+    static_assert(Bits >= 1 && Bits <= 32, "packed values are 1 to 32 bits wide");
+
+    constexpr unsigned bits() const noexcept { return Bits; }
+};
+
+struct RuntimeBitWidth
+{
+    unsigned bits_;
+
+    RuntimeBitWidth(unsigned bits);
+
+    unsigned bits() const noexcept { return bits_; }
+};
+
+// Unsigned values of a few bits each stored back to back in 64-bit words, lowest bits first, a value may
+// span two words. Generalizes Vector<bool> to ID and category columns that need 3 to 20 bits instead of
+// a whole uint32_t. Values are read and written by value, set() and pushBack() drop bits above the width.
+// Bits past the last value are always zero
+template<typename Width>
+class BasicPackedIntVector final
+{
+    Width width_;
+    Vector<uint64_t> words_;
+    size_t size_;
+
+public:
+    explicit BasicPackedIntVector(Width width = Width{});
+
+    unsigned bits() const noexcept;
+    uint32_t maxValue() const noexcept;
+
+    uint32_t get(size_t pos) const noexcept;
+    void     set(size_t pos, uint32_t value) noexcept;
+
+    uint32_t operator[](size_t pos) const noexcept;
+    uint32_t at(size_t pos) const;
+
+    bool   empty   () const noexcept;
+    size_t size    () const noexcept;
+    size_t capacity() const noexcept;
+
+    // Storage of values, (size() * bits() + 63) / 64 words
+    VectorView<const uint64_t> words() const noexcept;
+
+    void reserve(size_t newCapacity);
+    void clear() noexcept;
+
+    void pushBack(uint32_t value);
+    void popBack() noexcept;
+
+    // New values are zero
+    void resize(size_t newSize);
+
+    // Replaces the contents with values in a single pass over the words
+    void pack(VectorView<const uint32_t> values);
+
+    // out[i] = value from + i for every element of out, out must fit in size()
+    void unpack(size_t from, VectorView<uint32_t> out) const;
+
+    // All values into out, simd kernel does the decoding
+    template<typename Allocator>
+    void unpack(Vector<uint32_t, Allocator>& out) const;
+
+    void swap(BasicPackedIntVector& other);
+
+private:
+    uint64_t mask() const noexcept;
+    size_t   wordsFor(size_t count) const noexcept;
+
+    // Zeroes bits past the last value of the last word
+    void clearTail() noexcept;
+};
+
+template<unsigned Bits>
+using PackedIntVector = BasicPackedIntVector<FixedBitWidth<Bits> >;
+
+using DynamicPackedIntVector = BasicPackedIntVector<RuntimeBitWidth>;
+
+// --------------------------Implementation-----------------------------------
+
+inline RuntimeBitWidth::RuntimeBitWidth(unsigned bits) : bits_(bits)
+{
+    if (bits < 1 || bits > 32)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorCtorErr, "Packed values must be 1 to 32 bits wide", {}
+        );
+    }
+}
+
+template<typename Width>
+BasicPackedIntVector<Width>::BasicPackedIntVector(Width width) : width_(width), words_(), size_(0)
+{
+}
+
+template<typename Width>
+unsigned BasicPackedIntVector<Width>::bits() const noexcept
+{
+    return width_.bits();
+}
+
+template<typename Width>
+uint32_t BasicPackedIntVector<Width>::maxValue() const noexcept
+{
+    return static_cast<uint32_t>(mask());
+}
+
+template<typename Width>
+uint32_t BasicPackedIntVector<Width>::get(size_t pos) const noexcept
+{
+    size_t bitPos = pos * bits();
+    size_t word   = bitPos / 64;
+    size_t shift  = bitPos % 64;
+
+    uint64_t value = words_[word] >> shift;
+    if (shift + bits() > 64)
+        value |= words_[word + 1] << (64 - shift);
+
+    return static_cast<uint32_t>(value & mask());
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::set(size_t pos, uint32_t value) noexcept
+{
+    size_t bitPos = pos * bits();
+    size_t word   = bitPos / 64;
+    size_t shift  = bitPos % 64;
+
+    uint64_t masked = value & mask();
+
+    words_[word] = (words_[word] & ~(mask() << shift)) | (masked << shift);
+    if (shift + bits() > 64)
+    {
+        size_t highShift = 64 - shift;
+        words_[word + 1] = (words_[word + 1] & ~(mask() >> highShift)) | (masked >> highShift);
+    }
+}
+
+template<typename Width>
+uint32_t BasicPackedIntVector<Width>::operator[](size_t pos) const noexcept
+{
+    return get(pos);
+}
+
+template<typename Width>
+uint32_t BasicPackedIntVector<Width>::at(size_t pos) const
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds, "Index is out of bounds in packed int vector", {}
+        );
+    }
+
+    return get(pos);
+}
+
+template<typename Width>
+bool BasicPackedIntVector<Width>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename Width>
+size_t BasicPackedIntVector<Width>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename Width>
+size_t BasicPackedIntVector<Width>::capacity() const noexcept
+{
+    return words_.capacity() * 64 / bits();
+}
+
+template<typename Width>
+VectorView<const uint64_t> BasicPackedIntVector<Width>::words() const noexcept
+{
+    return VectorView<const uint64_t>{words_};
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::reserve(size_t newCapacity)
+{
+    words_.reserve(wordsFor(newCapacity));
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::clear() noexcept
+{
+    words_.clear();
+    size_ = 0;
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::pushBack(uint32_t value)
+{
+    // pushBack of the vector keeps growth geometric, resize would reserve exactly
+    while (words_.size() < wordsFor(size_ + 1))
+        words_.pushBack(0);
+
+    set(size_, value);
+    ++size_;
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::popBack() noexcept
+{
+    --size_;
+
+    while (words_.size() > wordsFor(size_))
+        words_.popBack();
+
+    clearTail();
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::resize(size_t newSize)
+{
+    words_.resize(wordsFor(newSize), 0);
+    size_ = newSize;
+
+    clearTail();
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::pack(VectorView<const uint32_t> values)
+{
+    words_.resize(wordsFor(values.size()), 0);
+    size_ = values.size();
+
+    uint64_t* word  = words_.data();
+    uint64_t  acc   = 0;
+    size_t    used  = 0;
+
+    // Values go into acc until it fills up, the part of a value past the full word starts the next one
+    for (size_t pos = 0; pos < values.size(); ++pos)
+    {
+        uint64_t value = values[pos] & mask();
+
+        acc  |= value << used;
+        used += bits();
+
+        if (used >= 64)
+        {
+            *word++ = acc;
+
+            used -= 64;
+            acc   = value >> (bits() - used);
+        }
+    }
+
+    if (used != 0)
+        *word = acc;
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::unpack(size_t from, VectorView<uint32_t> out) const
+{
+    if (from > size_ || out.size() > size_ - from)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds, "Unpacked range is out of bounds in packed int vector", {}
+        );
+    }
+
+    Simd::unpackBits(words_.data(), words_.size(), bits(), from, out.size(), out.data());
+}
+
+template<typename Width>
+template<typename Allocator>
+void BasicPackedIntVector<Width>::unpack(Vector<uint32_t, Allocator>& out) const
+{
+    out.resizeUninitialized(size_);
+
+    Simd::unpackBits(words_.data(), words_.size(), bits(), 0, size_, out.data());
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::swap(BasicPackedIntVector& other)
+{
+    std::swap(width_, other.width_);
+    std::swap(size_, other.size_);
+    words_.swap(other.words_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename Width>
+uint64_t BasicPackedIntVector<Width>::mask() const noexcept
+{
+    return (uint64_t(1) << bits()) - 1;
+}
+
+template<typename Width>
+size_t BasicPackedIntVector<Width>::wordsFor(size_t count) const noexcept
+{
+    return (count * bits() + 63) / 64;
+}
+
+template<typename Width>
+void BasicPackedIntVector<Width>::clearTail() noexcept
+{
+    size_t usedBits = size_ * bits() % 64;
+
+    if (usedBits != 0)
+        words_[words_.size() - 1] &= (uint64_t(1) << usedBits) - 1;
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_PACKED_INT_VECTOR_HPP
@@ -0,0 +1,497 @@
+#ifndef CONTAINERS_PERSISTENT_VECTOR_HPP
+#define CONTAINERS_PERSISTENT_VECTOR_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include "Vector.hpp"
+#include "Allocators/Allocator.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Immutable vector: 32-way trie of shared nodes plus a tail leaf, like Clojure's PersistentVector.
+// Copy is O(1), pushBack/set/popBack return a new vector and copy only the O(log32 n) nodes on the path.
+// Nodes are reference counted atomically, so snapshots can be handed to other threads.
+template<typename T>
+class PersistentVector final
+{
+    static constexpr size_t bits  = 5;
+    static constexpr size_t width = size_t(1) << bits;
+    static constexpr size_t mask  = width - 1;
+
+    struct Leaf;
+    struct Branch;
+
+    // Branch children are Branches above level bits and Leaves at level bits
+    using NodePtr = std::shared_ptr<const void>;
+
+    size_t size_;
+    size_t shift_;
+
+    NodePtr root_;
+    std::shared_ptr<const Leaf> tail_;
+
+public:
+    PersistentVector();
+
+    template<typename Allocator>
+    explicit PersistentVector(const Vector<T, Allocator>& vector);
+
+    PersistentVector(const PersistentVector& other) = default;
+    PersistentVector(PersistentVector&& other) = default;
+
+    PersistentVector& operator=(const PersistentVector& other) = default;
+    PersistentVector& operator=(PersistentVector&& other) = default;
+
+    ~PersistentVector() = default;
+
+    const T& at(size_t pos) const;
+    const T& operator[](size_t pos) const noexcept;
+
+    const T& front() const noexcept;
+    const T& back() const noexcept;
+
+    bool   empty() const noexcept;
+    size_t size () const noexcept;
+
+    PersistentVector pushBack(const T& value) const;
+    PersistentVector set(size_t pos, const T& value) const;
+    PersistentVector popBack() const;
+
+    // Calls func(const T* data, size_t count) for every leaf in order
+    template<typename Func>
+    void forEachLeaf(Func func) const;
+
+    Vector<T> toVector() const;
+
+private:
+    struct Leaf
+    {
+        size_t count;
+        alignas(T) char storage[width * sizeof(T)];
+
+        Leaf() noexcept : count(0) {}
+        Leaf(const Leaf& other);
+        Leaf& operator=(const Leaf& other) = delete;
+        ~Leaf();
+
+        const T* values() const noexcept { return reinterpret_cast<const T*>(storage); }
+        T*       values()       noexcept { return reinterpret_cast<T*>(storage); }
+
+        void push(const T& value);
+        void destroyValues() noexcept;
+    };
+
+    struct Branch
+    {
+        NodePtr children[width];
+
+        Branch() noexcept : children() {}
+    };
+
+    size_t tailOffset() const noexcept;
+    const Leaf* leafFor(size_t pos) const noexcept;
+    std::shared_ptr<const Leaf> treeLeaf(size_t pos) const noexcept;
+
+    NodePtr pushTail(size_t level, const Branch* parent, const NodePtr& tail) const;
+    NodePtr popTail (size_t level, const Branch* node) const;
+
+    static NodePtr newPath(size_t level, const NodePtr& node);
+    static NodePtr doSet  (size_t level, const void* node, size_t pos, const T& value);
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T>
+PersistentVector<T>::Leaf::Leaf(const Leaf& other) : count(0)
+{
+    // The destructor doesn't run for a constructor that throws, copies made so far are destroyed here
+    try
+    {
+        for (size_t pos = 0; pos < other.count; ++pos)
+            push(other.values()[pos]);
+    }
+    catch (...)
+    {
+        destroyValues();
+        throw;
+    }
+}
+
+template<typename T>
+PersistentVector<T>::Leaf::~Leaf()
+{
+    destroyValues();
+}
+
+template<typename T>
+void PersistentVector<T>::Leaf::destroyValues() noexcept
+{
+    for (size_t pos = 0; pos < count; ++pos)
+        values()[pos].~T();
+
+    count = 0;
+}
+
+template<typename T>
+void PersistentVector<T>::Leaf::push(const T& value)
+{
+    constructInMemory(values() + count, value);
+    ++count;
+}
+
+template<typename T>
+PersistentVector<T>::PersistentVector() :
+    size_(0), shift_(bits), root_(std::make_shared<const Branch>()), tail_(std::make_shared<const Leaf>())
+{
+}
+
+template<typename T>
+template<typename Allocator>
+PersistentVector<T>::PersistentVector(const Vector<T, Allocator>& vector) : PersistentVector()
+{
+    if (vector.empty())
+        return;
+
+    const T* data = vector.data();
+    size_t   size = vector.size();
+
+    // Everything but the last 1..width elements goes to full leaves, tree is then built bottom up
+    size_t treeSize    = (size - 1) / width * width;
+    size_t nodesCount  = treeSize / width;
+
+    Vector<NodePtr> nodes;
+    nodes.reserve(nodesCount);
+
+    for (size_t leafBegin = 0; leafBegin < treeSize; leafBegin += width)
+    {
+        std::shared_ptr<Leaf> leaf = std::make_shared<Leaf>();
+        for (size_t pos = leafBegin; pos < leafBegin + width; ++pos)
+            leaf->push(data[pos]);
+
+        nodes.pushBack(leaf);
+    }
+
+    size_t shift = bits;
+    while (nodesCount > width)
+    {
+        size_t parentsCount = (nodesCount + width - 1) / width;
+        for (size_t parent = 0; parent < parentsCount; ++parent)
+        {
+            std::shared_ptr<Branch> branch = std::make_shared<Branch>();
+            for (size_t child = 0; child < width && parent * width + child < nodesCount; ++child)
+                branch->children[child] = nodes[parent * width + child];
+
+            nodes[parent] = branch;
+        }
+
+        nodesCount = parentsCount;
+        shift += bits;
+    }
+
+    std::shared_ptr<Branch> root = std::make_shared<Branch>();
+    for (size_t child = 0; child < nodesCount; ++child)
+        root->children[child] = nodes[child];
+
+    std::shared_ptr<Leaf> tail = std::make_shared<Leaf>();
+    for (size_t pos = treeSize; pos < size; ++pos)
+        tail->push(data[pos]);
+
+    size_  = size;
+    shift_ = shift;
+    root_  = root;
+    tail_  = tail;
+}
+
+template<typename T>
+const T& PersistentVector<T>::at(size_t pos) const
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Persistent vector index out of bounds",
+            {}
+        );
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T>
+const T& PersistentVector<T>::operator[](size_t pos) const noexcept
+{
+    return leafFor(pos)->values()[pos & mask];
+}
+
+template<typename T>
+const T& PersistentVector<T>::front() const noexcept
+{
+    return (*this)[0];
+}
+
+template<typename T>
+const T& PersistentVector<T>::back() const noexcept
+{
+    return (*this)[size_ - 1];
+}
+
+template<typename T>
+bool PersistentVector<T>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename T>
+size_t PersistentVector<T>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::pushBack(const T& value) const
+{
+    PersistentVector result{*this};
+
+    if (size_ - tailOffset() < width)
+    {
+        std::shared_ptr<Leaf> tail = std::make_shared<Leaf>(*tail_);
+        tail->push(value);
+
+        result.tail_ = tail;
+        ++result.size_;
+
+        return result;
+    }
+
+    // Tail is full: it becomes a leaf of the tree
+    if ((size_ >> bits) > (size_t(1) << shift_))
+    {
+        std::shared_ptr<Branch> root = std::make_shared<Branch>();
+        root->children[0] = root_;
+        root->children[1] = newPath(shift_, tail_);
+
+        result.root_   = root;
+        result.shift_ += bits;
+    }
+    else
+        result.root_ = pushTail(shift_, static_cast<const Branch*>(root_.get()), tail_);
+
+    std::shared_ptr<Leaf> tail = std::make_shared<Leaf>();
+    tail->push(value);
+
+    result.tail_ = tail;
+    ++result.size_;
+
+    return result;
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::set(size_t pos, const T& value) const
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Persistent vector index out of bounds",
+            {}
+        );
+    }
+
+    PersistentVector result{*this};
+
+    if (pos >= tailOffset())
+    {
+        std::shared_ptr<Leaf> tail = std::make_shared<Leaf>(*tail_);
+        tail->values()[pos & mask] = value;
+
+        result.tail_ = tail;
+    }
+    else
+        result.root_ = doSet(shift_, root_.get(), pos, value);
+
+    return result;
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::popBack() const
+{
+    if (size_ <= 1)
+        return PersistentVector{};
+
+    PersistentVector result{*this};
+    --result.size_;
+
+    if (size_ - tailOffset() > 1)
+    {
+        std::shared_ptr<Leaf> tail = std::make_shared<Leaf>();
+        for (size_t pos = 0; pos + 1 < tail_->count; ++pos)
+            tail->push(tail_->values()[pos]);
+
+        result.tail_ = tail;
+        return result;
+    }
+
+    // Tail becomes empty: last leaf of the tree becomes the new tail
+    result.tail_ = treeLeaf(size_ - 2);
+
+    NodePtr root = popTail(shift_, static_cast<const Branch*>(root_.get()));
+    if (!root)
+        root = std::make_shared<const Branch>();
+
+    const Branch* rootBranch = static_cast<const Branch*>(root.get());
+    if (shift_ > bits && !rootBranch->children[1])
+    {
+        result.root_   = rootBranch->children[0];
+        result.shift_ -= bits;
+    }
+    else
+        result.root_ = root;
+
+    return result;
+}
+
+template<typename T>
+template<typename Func>
+void PersistentVector<T>::forEachLeaf(Func func) const
+{
+    for (size_t leafBegin = 0; leafBegin < tailOffset(); leafBegin += width)
+        func(leafFor(leafBegin)->values(), width);
+
+    if (tail_->count != 0)
+        func(tail_->values(), tail_->count);
+}
+
+template<typename T>
+Vector<T> PersistentVector<T>::toVector() const
+{
+    Vector<T> vector;
+    vector.reserve(size_);
+
+    forEachLeaf([&vector](const T* values, size_t count)
+    {
+        for (size_t pos = 0; pos < count; ++pos)
+            vector.pushBack(values[pos]);
+    });
+
+    return vector;
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T>
+size_t PersistentVector<T>::tailOffset() const noexcept
+{
+    return size_ < width ? 0 : ((size_ - 1) >> bits) << bits;
+}
+
+template<typename T>
+const typename PersistentVector<T>::Leaf* PersistentVector<T>::leafFor(size_t pos) const noexcept
+{
+    if (pos >= tailOffset())
+        return tail_.get();
+
+    const void* node = root_.get();
+    for (size_t level = shift_; level > 0; level -= bits)
+        node = static_cast<const Branch*>(node)->children[(pos >> level) & mask].get();
+
+    return static_cast<const Leaf*>(node);
+}
+
+template<typename T>
+std::shared_ptr<const typename PersistentVector<T>::Leaf> PersistentVector<T>::treeLeaf(size_t pos) const noexcept
+{
+    const Branch* node = static_cast<const Branch*>(root_.get());
+    for (size_t level = shift_; level > bits; level -= bits)
+        node = static_cast<const Branch*>(node->children[(pos >> level) & mask].get());
+
+    return std::static_pointer_cast<const Leaf>(node->children[(pos >> bits) & mask]);
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr
+    PersistentVector<T>::pushTail(size_t level, const Branch* parent, const NodePtr& tail) const
+{
+    size_t childId = ((size_ - 1) >> level) & mask;
+
+    std::shared_ptr<Branch> result = std::make_shared<Branch>(*parent);
+
+    if (level == bits)
+        result->children[childId] = tail;
+    else if (parent->children[childId])
+    {
+        const Branch* child = static_cast<const Branch*>(parent->children[childId].get());
+        result->children[childId] = pushTail(level - bits, child, tail);
+    }
+    else
+        result->children[childId] = newPath(level - bits, tail);
+
+    return result;
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr PersistentVector<T>::popTail(size_t level, const Branch* node) const
+{
+    size_t childId = ((size_ - 2) >> level) & mask;
+
+    if (level > bits)
+    {
+        NodePtr child = popTail(level - bits, static_cast<const Branch*>(node->children[childId].get()));
+        if (!child && childId == 0)
+            return nullptr;
+
+        std::shared_ptr<Branch> result = std::make_shared<Branch>(*node);
+        result->children[childId] = child;
+
+        return result;
+    }
+
+    if (childId == 0)
+        return nullptr;
+
+    std::shared_ptr<Branch> result = std::make_shared<Branch>(*node);
+    result->children[childId] = nullptr;
+
+    return result;
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr PersistentVector<T>::newPath(size_t level, const NodePtr& node)
+{
+    if (level == 0)
+        return node;
+
+    std::shared_ptr<Branch> result = std::make_shared<Branch>();
+    result->children[0] = newPath(level - bits, node);
+
+    return result;
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr
+    PersistentVector<T>::doSet(size_t level, const void* node, size_t pos, const T& value)
+{
+    if (level == 0)
+    {
+        std::shared_ptr<Leaf> result = std::make_shared<Leaf>(*static_cast<const Leaf*>(node));
+        result->values()[pos & mask] = value;
+
+        return result;
+    }
+
+    const Branch* branch = static_cast<const Branch*>(node);
+    size_t childId = (pos >> level) & mask;
+
+    std::shared_ptr<Branch> result = std::make_shared<Branch>(*branch);
+    result->children[childId] = doSet(level - bits, branch->children[childId].get(), pos, value);
+
+    return result;
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_PERSISTENT_VECTOR_HPP
@@ -0,0 +1,544 @@
+#ifndef CONTAINERS_SEGMENTED_VECTOR_HPP
+#define CONTAINERS_SEGMENTED_VECTOR_HPP
+
+#include <cstddef>
+
+#include "Vector.hpp"
+#include "CommonVectorFuncs.hpp"
+#include "Allocators/DynamicAllocator.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Segment k holds (1 << firstShift) << k elements, so index -> (segment, offset) is a couple of bit operations
+template<size_t firstShift = 4>
+struct GeometricSegments
+{
+    static size_t segment(size_t pos) noexcept;
+    static size_t offset (size_t pos, size_t segment) noexcept;
+
+    static size_t segmentCapacity(size_t segment) noexcept;
+};
+
+// Every segment holds 1 << shift elements. Works with StaticAllocator<T, 1 << shift> as segment allocator
+template<size_t shift = 12>
+struct FixedSegments
+{
+    static size_t segment(size_t pos) noexcept;
+    static size_t offset (size_t pos, size_t segment) noexcept;
+
+    static size_t segmentCapacity(size_t segment) noexcept;
+};
+
+// Elements live in segments that are never relocated: pushBack is O(1) in the worst case
+// and references stay valid until the element is popped.
+template<typename T, typename Segments = GeometricSegments<>, typename Allocator = DynamicAllocator<T> >
+class SegmentedVector final
+{
+    Vector<Allocator*> segments_; // segment directory, one allocator per segment
+    size_t size_;
+
+public:
+    template<typename Value>
+    class IteratorBase final
+    {
+        Allocator* const* segments_;
+        size_t segmentsCount_;
+        size_t segment_;
+
+        Value* ptr_;
+        Value* segmentEnd_;
+
+    public:
+        IteratorBase(Allocator* const* segments, size_t segmentsCount, size_t segment, Value* ptr, Value* segmentEnd)
+            noexcept;
+
+        IteratorBase& operator++() noexcept;
+        IteratorBase  operator++(int) noexcept;
+
+        Value& operator* () const noexcept { return *ptr_; }
+        Value* operator->() const noexcept { return ptr_; }
+
+        bool operator==(const IteratorBase& other) const noexcept { return ptr_ == other.ptr_; }
+        bool operator!=(const IteratorBase& other) const noexcept { return ptr_ != other.ptr_; }
+    };
+
+    using Iterator      = IteratorBase<T>;
+    using ConstIterator = IteratorBase<const T>;
+
+    SegmentedVector() noexcept;
+    SegmentedVector(const SegmentedVector& other);
+    SegmentedVector(SegmentedVector&& other) noexcept;
+
+    SegmentedVector& operator=(const SegmentedVector& other);
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept;
+
+    ~SegmentedVector();
+
+    T&       at(size_t pos);
+    const T& at(size_t pos) const;
+
+    T&       operator[](size_t pos) noexcept;
+    const T& operator[](size_t pos) const noexcept;
+
+    T&       front() noexcept;
+    const T& front() const noexcept;
+
+    T&       back() noexcept;
+    const T& back() const noexcept;
+
+    Iterator begin() noexcept;
+    Iterator end  () noexcept;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator end  () const noexcept;
+
+    bool   empty   () const noexcept;
+    size_t size    () const noexcept;
+    size_t capacity() const noexcept;
+
+    // Allocates segments up front, never moves existing elements
+    void reserve(size_t newCapacity);
+
+    void pushBack(const T& value);
+    void popBack() noexcept;
+
+    void clear() noexcept;
+
+    // Releases segments that hold no elements
+    void shrinkToFit() noexcept;
+
+    size_t   segmentsCount() const noexcept;
+    T*       segmentData(size_t segment) noexcept;
+    const T* segmentData(size_t segment) const noexcept;
+    size_t   segmentSize(size_t segment) const noexcept;
+
+    // Calls func(T* data, size_t count) for every non empty segment in order
+    template<typename Func>
+    void forEachSegment(Func func);
+
+    template<typename Func>
+    void forEachSegment(Func func) const;
+
+    void swap(SegmentedVector& other) noexcept;
+
+private:
+    void addSegment();
+    void freeSegments() noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<size_t firstShift>
+size_t GeometricSegments<firstShift>::segment(size_t pos) noexcept
+{
+    return highestBit((pos >> firstShift) + 1);
+}
+
+template<size_t firstShift>
+size_t GeometricSegments<firstShift>::offset(size_t pos, size_t segment) noexcept
+{
+    return pos - (((size_t(1) << segment) - 1) << firstShift);
+}
+
+template<size_t firstShift>
+size_t GeometricSegments<firstShift>::segmentCapacity(size_t segment) noexcept
+{
+    return (size_t(1) << firstShift) << segment;
+}
+
+template<size_t shift>
+size_t FixedSegments<shift>::segment(size_t pos) noexcept
+{
+    return pos >> shift;
+}
+
+template<size_t shift>
+size_t FixedSegments<shift>::offset(size_t pos, size_t) noexcept
+{
+    return pos & ((size_t(1) << shift) - 1);
+}
+
+template<size_t shift>
+size_t FixedSegments<shift>::segmentCapacity(size_t) noexcept
+{
+    return size_t(1) << shift;
+}
+
+template<typename T, typename Segments, typename Allocator>
+template<typename Value>
+SegmentedVector<T, Segments, Allocator>::IteratorBase<Value>::IteratorBase(
+    Allocator* const* segments, size_t segmentsCount, size_t segment, Value* ptr, Value* segmentEnd
+) noexcept :
+    segments_(segments), segmentsCount_(segmentsCount), segment_(segment), ptr_(ptr), segmentEnd_(segmentEnd)
+{
+}
+
+template<typename T, typename Segments, typename Allocator>
+template<typename Value>
+typename SegmentedVector<T, Segments, Allocator>::template IteratorBase<Value>&
+    SegmentedVector<T, Segments, Allocator>::IteratorBase<Value>::operator++() noexcept
+{
+    ++ptr_;
+    if (ptr_ != segmentEnd_)
+        return *this;
+
+    // Segments are filled one after another, so only the last non empty one ends before its capacity
+    if (segment_ + 1 < segmentsCount_ && segments_[segment_ + 1]->size() != 0)
+    {
+        ++segment_;
+        ptr_        = segments_[segment_]->data();
+        segmentEnd_ = ptr_ + segments_[segment_]->size();
+    }
+
+    return *this;
+}
+
+template<typename T, typename Segments, typename Allocator>
+template<typename Value>
+typename SegmentedVector<T, Segments, Allocator>::template IteratorBase<Value>
+    SegmentedVector<T, Segments, Allocator>::IteratorBase<Value>::operator++(int) noexcept
+{
+    IteratorBase tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+template<typename T, typename Segments, typename Allocator>
+SegmentedVector<T, Segments, Allocator>::SegmentedVector() noexcept : segments_(), size_(0)
+{
+}
+
+template<typename T, typename Segments, typename Allocator>
+SegmentedVector<T, Segments, Allocator>::SegmentedVector(const SegmentedVector& other) : SegmentedVector()
+{
+    // Delegated ctor has finished, so destructor frees segments if a copy throws
+    reserve(other.size_);
+    for (const T& value : other)
+        pushBack(value);
+}
+
+template<typename T, typename Segments, typename Allocator>
+SegmentedVector<T, Segments, Allocator>::SegmentedVector(SegmentedVector&& other) noexcept : SegmentedVector()
+{
+    swap(other);
+}
+
+template<typename T, typename Segments, typename Allocator>
+SegmentedVector<T, Segments, Allocator>&
+    SegmentedVector<T, Segments, Allocator>::operator=(const SegmentedVector& other)
+{
+    SegmentedVector copy{other};
+    swap(copy);
+    return *this;
+}
+
+template<typename T, typename Segments, typename Allocator>
+SegmentedVector<T, Segments, Allocator>&
+    SegmentedVector<T, Segments, Allocator>::operator=(SegmentedVector&& other) noexcept
+{
+    swap(other);
+    return *this;
+}
+
+template<typename T, typename Segments, typename Allocator>
+SegmentedVector<T, Segments, Allocator>::~SegmentedVector()
+{
+    freeSegments();
+}
+
+template<typename T, typename Segments, typename Allocator>
+T& SegmentedVector<T, Segments, Allocator>::at(size_t pos)
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Segmented vector index out of bounds",
+            {}
+        );
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Segments, typename Allocator>
+const T& SegmentedVector<T, Segments, Allocator>::at(size_t pos) const
+{
+    if (pos >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Segmented vector index out of bounds",
+            {}
+        );
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Segments, typename Allocator>
+T& SegmentedVector<T, Segments, Allocator>::operator[](size_t pos) noexcept
+{
+    size_t segment = Segments::segment(pos);
+    return segments_[segment]->data()[Segments::offset(pos, segment)];
+}
+
+template<typename T, typename Segments, typename Allocator>
+const T& SegmentedVector<T, Segments, Allocator>::operator[](size_t pos) const noexcept
+{
+    size_t segment = Segments::segment(pos);
+    return segments_[segment]->data()[Segments::offset(pos, segment)];
+}
+
+template<typename T, typename Segments, typename Allocator>
+T& SegmentedVector<T, Segments, Allocator>::front() noexcept
+{
+    return (*this)[0];
+}
+
+template<typename T, typename Segments, typename Allocator>
+const T& SegmentedVector<T, Segments, Allocator>::front() const noexcept
+{
+    return (*this)[0];
+}
+
+template<typename T, typename Segments, typename Allocator>
+T& SegmentedVector<T, Segments, Allocator>::back() noexcept
+{
+    return (*this)[size_ - 1];
+}
+
+template<typename T, typename Segments, typename Allocator>
+const T& SegmentedVector<T, Segments, Allocator>::back() const noexcept
+{
+    return (*this)[size_ - 1];
+}
+
+template<typename T, typename Segments, typename Allocator>
+typename SegmentedVector<T, Segments, Allocator>::Iterator SegmentedVector<T, Segments, Allocator>::begin() noexcept
+{
+    if (size_ == 0)
+        return end();
+
+    T* data = segments_[0]->data();
+    return Iterator{segments_.data(), segments_.size(), 0, data, data + segments_[0]->size()};
+}
+
+template<typename T, typename Segments, typename Allocator>
+typename SegmentedVector<T, Segments, Allocator>::Iterator SegmentedVector<T, Segments, Allocator>::end() noexcept
+{
+    if (size_ == 0)
+        return Iterator{segments_.data(), segments_.size(), 0, nullptr, nullptr};
+
+    size_t lastSegment = Segments::segment(size_ - 1);
+    T* lastEnd = &back() + 1;
+
+    return Iterator{segments_.data(), segments_.size(), lastSegment, lastEnd, lastEnd};
+}
+
+template<typename T, typename Segments, typename Allocator>
+typename SegmentedVector<T, Segments, Allocator>::ConstIterator
+    SegmentedVector<T, Segments, Allocator>::begin() const noexcept
+{
+    if (size_ == 0)
+        return end();
+
+    const T* data = segments_[0]->data();
+    return ConstIterator{segments_.data(), segments_.size(), 0, data, data + segments_[0]->size()};
+}
+
+template<typename T, typename Segments, typename Allocator>
+typename SegmentedVector<T, Segments, Allocator>::ConstIterator
+    SegmentedVector<T, Segments, Allocator>::end() const noexcept
+{
+    if (size_ == 0)
+        return ConstIterator{segments_.data(), segments_.size(), 0, nullptr, nullptr};
+
+    size_t lastSegment = Segments::segment(size_ - 1);
+    const T* lastEnd = &back() + 1;
+
+    return ConstIterator{segments_.data(), segments_.size(), lastSegment, lastEnd, lastEnd};
+}
+
+template<typename T, typename Segments, typename Allocator>
+bool SegmentedVector<T, Segments, Allocator>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename T, typename Segments, typename Allocator>
+size_t SegmentedVector<T, Segments, Allocator>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, typename Segments, typename Allocator>
+size_t SegmentedVector<T, Segments, Allocator>::capacity() const noexcept
+{
+    size_t capacity = 0;
+    for (size_t segment = 0; segment < segments_.size(); ++segment)
+        capacity += Segments::segmentCapacity(segment);
+
+    return capacity;
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::reserve(size_t newCapacity)
+{
+    if (newCapacity == 0)
+        return;
+
+    size_t neededSegments = Segments::segment(newCapacity - 1) + 1;
+    while (segments_.size() < neededSegments)
+        addSegment();
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::pushBack(const T& value)
+{
+    size_t segment = Segments::segment(size_);
+    if (segment == segments_.size())
+        addSegment();
+
+    Allocator& allocator = *segments_[segment];
+
+    try
+    {
+        allocator[Segments::offset(size_, segment)] = value;
+    }
+    catch (ExceptionWithReason& exception)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorCtorErr,
+            "Failed to copy element while pushing to segmented vector",
+            std::move(exception)
+        );
+    }
+
+    ++size_;
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::popBack() noexcept
+{
+    --size_;
+
+    size_t segment = Segments::segment(size_);
+    size_t offset  = Segments::offset(size_, segment);
+
+    segments_[segment]->dtorElements(offset, offset + 1);
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::clear() noexcept
+{
+    for (size_t segment = 0; segment < segments_.size(); ++segment)
+        segments_[segment]->dtorElements(0, segments_[segment]->size());
+
+    size_ = 0;
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::shrinkToFit() noexcept
+{
+    size_t usedSegments = size_ == 0 ? 0 : Segments::segment(size_ - 1) + 1;
+
+    while (segments_.size() > usedSegments)
+    {
+        delete segments_.back();
+        segments_.popBack();
+    }
+}
+
+template<typename T, typename Segments, typename Allocator>
+size_t SegmentedVector<T, Segments, Allocator>::segmentsCount() const noexcept
+{
+    return segments_.size();
+}
+
+template<typename T, typename Segments, typename Allocator>
+T* SegmentedVector<T, Segments, Allocator>::segmentData(size_t segment) noexcept
+{
+    return segments_[segment]->data();
+}
+
+template<typename T, typename Segments, typename Allocator>
+const T* SegmentedVector<T, Segments, Allocator>::segmentData(size_t segment) const noexcept
+{
+    return static_cast<const Allocator*>(segments_[segment])->data();
+}
+
+template<typename T, typename Segments, typename Allocator>
+size_t SegmentedVector<T, Segments, Allocator>::segmentSize(size_t segment) const noexcept
+{
+    return segments_[segment]->size();
+}
+
+template<typename T, typename Segments, typename Allocator>
+template<typename Func>
+void SegmentedVector<T, Segments, Allocator>::forEachSegment(Func func)
+{
+    for (size_t segment = 0; segment < segments_.size() && segments_[segment]->size() != 0; ++segment)
+        func(segments_[segment]->data(), segments_[segment]->size());
+}
+
+template<typename T, typename Segments, typename Allocator>
+template<typename Func>
+void SegmentedVector<T, Segments, Allocator>::forEachSegment(Func func) const
+{
+    for (size_t segment = 0; segment < segments_.size() && segments_[segment]->size() != 0; ++segment)
+        func(segmentData(segment), segments_[segment]->size());
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::swap(SegmentedVector& other) noexcept
+{
+    segments_.swap(other.segments_);
+    std::swap(size_, other.size_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::addSegment()
+{
+    Allocator* segment = nullptr;
+
+    try
+    {
+        segment = new Allocator{Segments::segmentCapacity(segments_.size())};
+        segments_.pushBack(segment);
+    }
+    catch (std::bad_alloc&)
+    {
+        delete segment;
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::MemAllocErr,
+            "Failed to allocate segment in segmented vector",
+            {}
+        );
+    }
+    catch (...)
+    {
+        delete segment;
+        throw;
+    }
+}
+
+template<typename T, typename Segments, typename Allocator>
+void SegmentedVector<T, Segments, Allocator>::freeSegments() noexcept
+{
+    for (size_t segment = 0; segment < segments_.size(); ++segment)
+        delete segments_[segment];
+
+    segments_.clear();
+    size_ = 0;
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_SEGMENTED_VECTOR_HPP
@@ -0,0 +1,284 @@
+#ifndef CONTAINERS_SHARDED_VECTOR_HPP
+#define CONTAINERS_SHARDED_VECTOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "Parallel/CacheLine.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// One Vector per producer: threads append to their own shard without locks, shard headers sit on separate
+// cache lines so they never share one. Caller picks shard ids, e.g. parallelFor chunk id modulo shardsCount(),
+// and a shard must not be used by two threads at once. Reading the whole sequence needs producers to be done:
+// iterators chain shards in id order without copying, concatenate() gathers them with one reservation
+template<typename T, typename Allocator = DynamicAllocator<T> >
+class ShardedVector final
+{
+    struct alignas(cacheLineSize) Shard
+    {
+        Vector<T, Allocator> values;
+
+        Shard() : values() {}
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shardsCount_;
+
+public:
+    template<typename Value>
+    class IteratorBase final
+    {
+        using ShardPointer = std::conditional_t<std::is_const<Value>::value, const Shard*, Shard*>;
+
+        ShardPointer shards_;
+        size_t shardsCount_;
+        size_t shard_;
+
+        Value* ptr_;
+        Value* shardEnd_;
+
+    public:
+        // Starts at the first element of shard or later, end() when no shard from there on has elements
+        IteratorBase(ShardPointer shards, size_t shardsCount, size_t shard) noexcept;
+
+        IteratorBase& operator++() noexcept;
+        IteratorBase  operator++(int) noexcept;
+
+        Value& operator* () const noexcept { return *ptr_; }
+        Value* operator->() const noexcept { return ptr_; }
+
+        bool operator==(const IteratorBase& other) const noexcept { return ptr_ == other.ptr_; }
+        bool operator!=(const IteratorBase& other) const noexcept { return ptr_ != other.ptr_; }
+
+    private:
+        void skipEmptyShards() noexcept;
+    };
+
+    using Iterator      = IteratorBase<T>;
+    using ConstIterator = IteratorBase<const T>;
+
+    explicit ShardedVector(size_t shardsCount);
+
+    ShardedVector(const ShardedVector& other) = delete;
+    ShardedVector& operator=(const ShardedVector& other) = delete;
+
+    size_t shardsCount() const noexcept;
+
+    Vector<T, Allocator>&       shard(size_t shardId) noexcept;
+    const Vector<T, Allocator>& shard(size_t shardId) const noexcept;
+
+    void pushBack(size_t shardId, const T& value);
+
+    Iterator begin() noexcept;
+    Iterator end  () noexcept;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator end  () const noexcept;
+
+    // Walk all shards, no shard may be appended to meanwhile
+    bool   empty() const noexcept;
+    size_t size () const noexcept;
+
+    // Shards one after another, reserves the target once. Trivially copyable elements are copied as bytes
+    template<typename OtherAllocator>
+    void appendTo(Vector<T, OtherAllocator>& target) const;
+
+    Vector<T, Allocator> concatenate() const;
+
+    void clear() noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator>
+template<typename Value>
+ShardedVector<T, Allocator>::IteratorBase<Value>::IteratorBase(ShardPointer shards, size_t shardsCount, size_t shard)
+    noexcept : shards_(shards), shardsCount_(shardsCount), shard_(shard), ptr_(nullptr), shardEnd_(nullptr)
+{
+    skipEmptyShards();
+}
+
+template<typename T, typename Allocator>
+template<typename Value>
+typename ShardedVector<T, Allocator>::template IteratorBase<Value>&
+    ShardedVector<T, Allocator>::IteratorBase<Value>::operator++() noexcept
+{
+    ++ptr_;
+    if (ptr_ != shardEnd_)
+        return *this;
+
+    ++shard_;
+    skipEmptyShards();
+
+    return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename Value>
+typename ShardedVector<T, Allocator>::template IteratorBase<Value>
+    ShardedVector<T, Allocator>::IteratorBase<Value>::operator++(int) noexcept
+{
+    IteratorBase tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+template<typename T, typename Allocator>
+template<typename Value>
+void ShardedVector<T, Allocator>::IteratorBase<Value>::skipEmptyShards() noexcept
+{
+    while (shard_ < shardsCount_ && shards_[shard_].values.empty())
+        ++shard_;
+
+    // Past the last element every iterator is the same null end
+    if (shard_ == shardsCount_)
+    {
+        ptr_      = nullptr;
+        shardEnd_ = nullptr;
+        return;
+    }
+
+    ptr_      = shards_[shard_].values.data();
+    shardEnd_ = ptr_ + shards_[shard_].values.size();
+}
+
+template<typename T, typename Allocator>
+ShardedVector<T, Allocator>::ShardedVector(size_t shardsCount) : shards_(), shardsCount_(shardsCount)
+{
+    if (shardsCount == 0)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorCtorErr, "Sharded vector needs at least one shard", {}
+        );
+    }
+
+    shards_.reset(new Shard[shardsCount]);
+}
+
+template<typename T, typename Allocator>
+size_t ShardedVector<T, Allocator>::shardsCount() const noexcept
+{
+    return shardsCount_;
+}
+
+template<typename T, typename Allocator>
+Vector<T, Allocator>& ShardedVector<T, Allocator>::shard(size_t shardId) noexcept
+{
+    return shards_[shardId].values;
+}
+
+template<typename T, typename Allocator>
+const Vector<T, Allocator>& ShardedVector<T, Allocator>::shard(size_t shardId) const noexcept
+{
+    return shards_[shardId].values;
+}
+
+template<typename T, typename Allocator>
+void ShardedVector<T, Allocator>::pushBack(size_t shardId, const T& value)
+{
+    shards_[shardId].values.pushBack(value);
+}
+
+template<typename T, typename Allocator>
+typename ShardedVector<T, Allocator>::Iterator ShardedVector<T, Allocator>::begin() noexcept
+{
+    return Iterator{shards_.get(), shardsCount_, 0};
+}
+
+template<typename T, typename Allocator>
+typename ShardedVector<T, Allocator>::Iterator ShardedVector<T, Allocator>::end() noexcept
+{
+    return Iterator{shards_.get(), shardsCount_, shardsCount_};
+}
+
+template<typename T, typename Allocator>
+typename ShardedVector<T, Allocator>::ConstIterator ShardedVector<T, Allocator>::begin() const noexcept
+{
+    return ConstIterator{shards_.get(), shardsCount_, 0};
+}
+
+template<typename T, typename Allocator>
+typename ShardedVector<T, Allocator>::ConstIterator ShardedVector<T, Allocator>::end() const noexcept
+{
+    return ConstIterator{shards_.get(), shardsCount_, shardsCount_};
+}
+
+template<typename T, typename Allocator>
+bool ShardedVector<T, Allocator>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<typename T, typename Allocator>
+size_t ShardedVector<T, Allocator>::size() const noexcept
+{
+    size_t total = 0;
+    for (size_t shardId = 0; shardId < shardsCount_; ++shardId)
+        total += shards_[shardId].values.size();
+
+    return total;
+}
+
+template<typename T, typename Allocator>
+template<typename OtherAllocator>
+void ShardedVector<T, Allocator>::appendTo(Vector<T, OtherAllocator>& target) const
+{
+    size_t oldSize = target.size();
+    size_t newSize = oldSize + size();
+
+    target.reserve(newSize);
+
+    if constexpr (std::is_trivially_copyable<T>::value)
+    {
+        target.resizeUninitialized(newSize);
+
+        T* destination = target.data() + oldSize;
+        for (size_t shardId = 0; shardId < shardsCount_; ++shardId)
+        {
+            const Vector<T, Allocator>& values = shards_[shardId].values;
+
+            if (!values.empty())
+                memcpy(destination, values.data(), values.size() * sizeof(T));
+
+            destination += values.size();
+        }
+    }
+    else
+    {
+        for (size_t shardId = 0; shardId < shardsCount_; ++shardId)
+        {
+            const Vector<T, Allocator>& values = shards_[shardId].values;
+
+            for (size_t pos = 0; pos < values.size(); ++pos)
+                target.pushBack(values[pos]);
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+Vector<T, Allocator> ShardedVector<T, Allocator>::concatenate() const
+{
+    Vector<T, Allocator> result;
+    appendTo(result);
+
+    return result;
+}
+
+template<typename T, typename Allocator>
+void ShardedVector<T, Allocator>::clear() noexcept
+{
+    for (size_t shardId = 0; shardId < shardsCount_; ++shardId)
+        shards_[shardId].values.clear();
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_SHARDED_VECTOR_HPP
@@ -0,0 +1,424 @@
+#ifndef CONTAINERS_SOA_VECTOR_HPP
+#define CONTAINERS_SOA_VECTOR_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "CommonVectorFuncs.hpp"
+#include "Allocators/AlignedAllocator.hpp"
+#include "Allocators/DynamicAllocator.hpp"
+#include "Allocators/StaticAllocator.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Column allocator policies: Columns::Allocator<Field> is the backend used for one column
+
+template<size_t alignment = cacheLineSize>
+struct AlignedColumns
+{
+    template<typename Field>
+    using Allocator = AlignedAllocator<Field, alignment>;
+};
+
+struct DynamicColumns
+{
+    template<typename Field>
+    using Allocator = DynamicAllocator<Field>;
+};
+
+template<size_t capacity>
+struct StaticColumns
+{
+    template<typename Field>
+    using Allocator = StaticAllocator<Field, capacity>;
+};
+
+// Structure of arrays: every field is stored in its own contiguous column, so a scan over one field
+// touches only that field's cache lines. All columns always have the same size and capacity.
+template<typename Columns, typename... Fields>
+class BasicSoaVector final
+{
+    static_assert(sizeof...(Fields) > 0, "soa vector needs at least one field");
+
+    template<size_t field>
+    using FieldType = typename std::tuple_element<field, std::tuple<Fields...> >::type;
+
+    std::tuple<typename Columns::template Allocator<Fields>...> columns_;
+    size_t size_;
+
+    // Pointer owning columns swap in O(1), StaticColumns swap copies elements and may throw
+    static constexpr bool nothrowSwap = (noexcept(
+        std::declval<typename Columns::template Allocator<Fields>&>().swap(
+            std::declval<typename Columns::template Allocator<Fields>&>()
+        )
+    ) && ...);
+
+public:
+    template<typename Container>
+    class RowProxy final
+    {
+        Container* vector_;
+        size_t row_;
+
+    public:
+        RowProxy(Container* vector, size_t row) noexcept : vector_(vector), row_(row) {}
+
+        template<size_t field>
+        decltype(auto) get() const noexcept { return vector_->template get<field>(row_); }
+
+        size_t index() const noexcept { return row_; }
+    };
+
+    using Row      = RowProxy<BasicSoaVector>;
+    using ConstRow = RowProxy<const BasicSoaVector>;
+
+    BasicSoaVector();
+    explicit BasicSoaVector(size_t capacity);
+
+    BasicSoaVector(const BasicSoaVector& other);
+    BasicSoaVector(BasicSoaVector&& other) noexcept(nothrowSwap);
+
+    BasicSoaVector& operator=(const BasicSoaVector& other);
+    BasicSoaVector& operator=(BasicSoaVector&& other) noexcept(nothrowSwap);
+
+    ~BasicSoaVector() = default;
+
+    Row      operator[](size_t row) noexcept;
+    ConstRow operator[](size_t row) const noexcept;
+
+    Row      at(size_t row);
+    ConstRow at(size_t row) const;
+
+    template<size_t field>
+    FieldType<field>& get(size_t row) noexcept;
+
+    template<size_t field>
+    const FieldType<field>& get(size_t row) const noexcept;
+
+    // Contiguous column, size() elements, for simd scans
+    template<size_t field>
+    FieldType<field>* column() noexcept;
+
+    template<size_t field>
+    const FieldType<field>* column() const noexcept;
+
+    bool   empty   () const noexcept;
+    size_t size    () const noexcept;
+    size_t capacity() const noexcept;
+
+    // All columns are reallocated together, nothing changes if one of them fails
+    void reserve(size_t newCapacity);
+
+    void pushBack(const Fields&... values);
+
+    // Constructs every field of the new row from the matching argument
+    template<typename... Args>
+    void emplaceBack(Args&&... args);
+
+    void popBack() noexcept;
+    void clear() noexcept;
+
+    void swap(BasicSoaVector& other) noexcept(nothrowSwap);
+
+private:
+    template<size_t... fields>
+    void reserveColumns(size_t newCapacity, std::index_sequence<fields...>);
+
+    template<size_t... fields>
+    void swapColumns(BasicSoaVector& other, std::index_sequence<fields...>) noexcept(nothrowSwap);
+
+    template<typename Column, typename Arg>
+    static void constructField(Column& column, size_t row, Arg&& arg);
+
+    template<size_t... fields, typename... Args>
+    void constructRow(std::index_sequence<fields...>, Args&&... args);
+
+    template<size_t... fields>
+    void destroyRow(size_t row, size_t constructedFields, std::index_sequence<fields...>) noexcept;
+
+    template<size_t... fields>
+    void moveRowIn(std::tuple<Fields...>& row, std::index_sequence<fields...>);
+};
+
+template<typename... Fields>
+using SoaVector = BasicSoaVector<AlignedColumns<>, Fields...>;
+
+// --------------------------Implementation-----------------------------------
+
+template<typename Columns, typename... Fields>
+BasicSoaVector<Columns, Fields...>::BasicSoaVector() : columns_(), size_(0)
+{
+}
+
+template<typename Columns, typename... Fields>
+BasicSoaVector<Columns, Fields...>::BasicSoaVector(size_t capacity) : BasicSoaVector()
+{
+    reserve(capacity);
+}
+
+template<typename Columns, typename... Fields>
+BasicSoaVector<Columns, Fields...>::BasicSoaVector(const BasicSoaVector& other) :
+    columns_(other.columns_), size_(other.size_)
+{
+}
+
+template<typename Columns, typename... Fields>
+BasicSoaVector<Columns, Fields...>::BasicSoaVector(BasicSoaVector&& other) noexcept(nothrowSwap) : BasicSoaVector()
+{
+    swap(other);
+}
+
+template<typename Columns, typename... Fields>
+BasicSoaVector<Columns, Fields...>& BasicSoaVector<Columns, Fields...>::operator=(const BasicSoaVector& other)
+{
+    BasicSoaVector copy{other};
+    swap(copy);
+    return *this;
+}
+
+template<typename Columns, typename... Fields>
+BasicSoaVector<Columns, Fields...>&
+    BasicSoaVector<Columns, Fields...>::operator=(BasicSoaVector&& other) noexcept(nothrowSwap)
+{
+    BasicSoaVector tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+}
+
+template<typename Columns, typename... Fields>
+typename BasicSoaVector<Columns, Fields...>::Row BasicSoaVector<Columns, Fields...>::operator[](size_t row) noexcept
+{
+    return Row{this, row};
+}
+
+template<typename Columns, typename... Fields>
+typename BasicSoaVector<Columns, Fields...>::ConstRow
+    BasicSoaVector<Columns, Fields...>::operator[](size_t row) const noexcept
+{
+    return ConstRow{this, row};
+}
+
+template<typename Columns, typename... Fields>
+typename BasicSoaVector<Columns, Fields...>::Row BasicSoaVector<Columns, Fields...>::at(size_t row)
+{
+    if (row >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Soa vector index out of bounds",
+            {}
+        );
+    }
+
+    return Row{this, row};
+}
+
+template<typename Columns, typename... Fields>
+typename BasicSoaVector<Columns, Fields...>::ConstRow BasicSoaVector<Columns, Fields...>::at(size_t row) const
+{
+    if (row >= size_)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorIndexOutOfBounds,
+            "Soa vector index out of bounds",
+            {}
+        );
+    }
+
+    return ConstRow{this, row};
+}
+
+template<typename Columns, typename... Fields>
+template<size_t field>
+typename BasicSoaVector<Columns, Fields...>::template FieldType<field>&
+    BasicSoaVector<Columns, Fields...>::get(size_t row) noexcept
+{
+    return column<field>()[row];
+}
+
+template<typename Columns, typename... Fields>
+template<size_t field>
+const typename BasicSoaVector<Columns, Fields...>::template FieldType<field>&
+    BasicSoaVector<Columns, Fields...>::get(size_t row) const noexcept
+{
+    return column<field>()[row];
+}
+
+template<typename Columns, typename... Fields>
+template<size_t field>
+typename BasicSoaVector<Columns, Fields...>::template FieldType<field>*
+    BasicSoaVector<Columns, Fields...>::column() noexcept
+{
+    return std::get<field>(columns_).data();
+}
+
+template<typename Columns, typename... Fields>
+template<size_t field>
+const typename BasicSoaVector<Columns, Fields...>::template FieldType<field>*
+    BasicSoaVector<Columns, Fields...>::column() const noexcept
+{
+    return std::get<field>(columns_).data();
+}
+
+template<typename Columns, typename... Fields>
+bool BasicSoaVector<Columns, Fields...>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename Columns, typename... Fields>
+size_t BasicSoaVector<Columns, Fields...>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename Columns, typename... Fields>
+size_t BasicSoaVector<Columns, Fields...>::capacity() const noexcept
+{
+    return std::get<0>(columns_).capacity();
+}
+
+template<typename Columns, typename... Fields>
+void BasicSoaVector<Columns, Fields...>::reserve(size_t newCapacity)
+{
+    if (newCapacity <= capacity())
+        return;
+
+    reserveColumns(newCapacity, std::index_sequence_for<Fields...>{});
+}
+
+template<typename Columns, typename... Fields>
+void BasicSoaVector<Columns, Fields...>::pushBack(const Fields&... values)
+{
+    emplaceBack(values...);
+}
+
+template<typename Columns, typename... Fields>
+template<typename... Args>
+void BasicSoaVector<Columns, Fields...>::emplaceBack(Args&&... args)
+{
+    static_assert(sizeof...(Args) == sizeof...(Fields), "emplaceBack needs one argument per field");
+
+    if (size_ != capacity())
+    {
+        constructRow(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+        ++size_;
+        return;
+    }
+
+    // args may refer into the columns that growth frees, so the row is built from copies made before it
+    std::tuple<Fields...> row{std::forward<Args>(args)...};
+
+    reserve(getCapacityAfterGrowth(capacity()));
+
+    moveRowIn(row, std::index_sequence_for<Fields...>{});
+    ++size_;
+}
+
+template<typename Columns, typename... Fields>
+void BasicSoaVector<Columns, Fields...>::popBack() noexcept
+{
+    --size_;
+    destroyRow(size_, sizeof...(Fields), std::index_sequence_for<Fields...>{});
+}
+
+template<typename Columns, typename... Fields>
+void BasicSoaVector<Columns, Fields...>::clear() noexcept
+{
+    while (size_ != 0)
+        popBack();
+}
+
+template<typename Columns, typename... Fields>
+void BasicSoaVector<Columns, Fields...>::swap(BasicSoaVector& other) noexcept(nothrowSwap)
+{
+    swapColumns(other, std::index_sequence_for<Fields...>{});
+    std::swap(size_, other.size_);
+}
+
+// ------------------------------Private------------------------------
+
+template<typename Columns, typename... Fields>
+template<size_t... fields>
+void BasicSoaVector<Columns, Fields...>::reserveColumns(size_t newCapacity, std::index_sequence<fields...>)
+{
+    // Every new column is filled before any old one is touched. Columns are allocated in place,
+    // the allocators have no move constructor and building them from temporaries would copy each one
+    std::tuple<typename Columns::template Allocator<Fields>...> newColumns{};
+
+    (std::get<fields>(newColumns).realloc(newCapacity), ...);
+    (copyData(std::get<fields>(newColumns), 0, std::get<fields>(columns_).data(), size_), ...);
+
+    (std::get<fields>(columns_).swap(std::get<fields>(newColumns)), ...);
+}
+
+template<typename Columns, typename... Fields>
+template<size_t... fields>
+void BasicSoaVector<Columns, Fields...>::swapColumns(
+    BasicSoaVector& other, std::index_sequence<fields...>
+) noexcept(nothrowSwap)
+{
+    (std::get<fields>(columns_).swap(std::get<fields>(other.columns_)), ...);
+}
+
+template<typename Columns, typename... Fields>
+template<typename Column, typename Arg>
+void BasicSoaVector<Columns, Fields...>::constructField(Column& column, size_t row, Arg&& arg)
+{
+    using Field = typename std::remove_reference<decltype(*column.data())>::type;
+
+    new (column.data() + row) Field(std::forward<Arg>(arg));
+    column.size(row + 1);
+}
+
+template<typename Columns, typename... Fields>
+template<size_t... fields, typename... Args>
+void BasicSoaVector<Columns, Fields...>::constructRow(std::index_sequence<fields...>, Args&&... args)
+{
+    size_t constructed = 0;
+
+    try
+    {
+        ((constructField(std::get<fields>(columns_), size_, std::forward<Args>(args)), ++constructed), ...);
+    }
+    catch (ExceptionWithReason& exception)
+    {
+        destroyRow(size_, constructed, std::index_sequence<fields...>{});
+
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorCtorErr,
+            "Failed to construct row in soa vector",
+            std::move(exception)
+        );
+    }
+    catch (...)
+    {
+        destroyRow(size_, constructed, std::index_sequence<fields...>{});
+        throw;
+    }
+}
+
+template<typename Columns, typename... Fields>
+template<size_t... fields>
+void BasicSoaVector<Columns, Fields...>::destroyRow(
+    size_t row, size_t constructedFields, std::index_sequence<fields...>
+) noexcept
+{
+    ((fields < constructedFields ? std::get<fields>(columns_).dtorElements(row, row + 1) : void()), ...);
+}
+
+template<typename Columns, typename... Fields>
+template<size_t... fields>
+void BasicSoaVector<Columns, Fields...>::moveRowIn(std::tuple<Fields...>& row, std::index_sequence<fields...>)
+{
+    constructRow(std::index_sequence<fields...>{}, std::move(std::get<fields>(row))...);
+}
+
+} // namespace MyStd
+
+#endif // CONTAINERS_SOA_VECTOR_HPP
@@ -12,6 +12,15 @@ enum class StdErrors
     VectorIndexOutOfBounds,
     VectorOnStackNotEnoughMemory,
     AllocatorCtorErr,
+    ThreadPoolCtorErr,
+    ReclaimerCtorErr,
+    VectorSizeMismatch,
+    SnapshotIoErr,
+    SnapshotFormatErr,
+    SnapshotChecksumErr,
+    FileMapErr,
+    KeyNotFound,
+    FdIoErr,
 };
 
 } // namespace MyStd
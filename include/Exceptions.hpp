@@ -1,6 +1,8 @@
 #ifndef EXCEPTIONS_HPP
 #define EXCEPTIONS_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <exception>
 #include <memory>
 #include <iostream>
@@ -13,14 +15,53 @@ namespace MyStd
 #define EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(ERROR, REASON, PREV_EXCEPTION) \
     ExceptionWithReason{ERROR, REASON, PREV_EXCEPTION, __func__, __FILE__, __LINE__}
 
+// Code built with -fno-exceptions: a throw prints the reason chain and aborts, catch blocks are compiled out
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+
+#define THROW_EXCEPTION_WITH_REASON(ERROR, REASON, PREV_EXCEPTION) \
+    throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(ERROR, REASON, PREV_EXCEPTION)
+
+#define EXCEPTIONS_TRY                    try
+#define EXCEPTIONS_CATCH(DECLARATION)     catch (DECLARATION)
+#define EXCEPTIONS_CATCH_WITH_REASON(NAME) catch (ExceptionWithReason& NAME)
+#define EXCEPTIONS_RETHROW                throw
+
+#else
+
+#define THROW_EXCEPTION_WITH_REASON(ERROR, REASON, PREV_EXCEPTION) \
+    terminateWithException(EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(ERROR, REASON, PREV_EXCEPTION))
+
+#define EXCEPTIONS_TRY                    if (true)
+#define EXCEPTIONS_CATCH(DECLARATION)     else if (false)
+#define EXCEPTIONS_CATCH_WITH_REASON(NAME) else if (ExceptionWithReason NAME{}; false)
+#define EXCEPTIONS_RETHROW                std::terminate()
+
+#endif
+
+// Creating and chaining never allocates: the exception keeps the error code, reason pointer and source location
+// of itself and of its causes inline. The chain is turned into text only when what() is called.
+// Reasons must outlive the exception, string literals in practice.
 class ExceptionWithReason : public std::exception
 {
-    StdErrors error_;
+public:
+    static constexpr size_t maxChainLength = 8;
+
+    struct Frame
+    {
+        StdErrors error;
+        const char* reason;
+        const char* function; // nullptr when location is unknown
+        const char* file;
+        size_t line;
+    };
 
-    std::unique_ptr<char> reasonString_;
-    std::unique_ptr<ExceptionWithReason> prevException_;
+private:
+    Frame frames_[maxChainLength]; // frames_[0] is this exception, the rest are its causes from newest to oldest
+    size_t framesCount_;
+    size_t droppedFrames_;         // oldest causes that didn't fit into frames_
 
-    std::unique_ptr<std::exception> prevStdException_;
+    // Set once by the first what(), threads racing on it keep the first published text and free their own
+    mutable std::atomic<char*> message_;
 
 public:
     ExceptionWithReason() noexcept;
@@ -39,11 +80,20 @@ public:
     ExceptionWithReason& operator=(const ExceptionWithReason& other) = delete;
     ExceptionWithReason& operator=(ExceptionWithReason&& other) noexcept;
 
+    StdErrors error() const noexcept;
+
+    size_t chainLength() const noexcept;
+    const Frame& frame(size_t pos) const noexcept;
+
+    // Formats the whole chain on the first call, the text lives as long as the exception
     const char* what() const noexcept override;
 
-    ~ExceptionWithReason() = default;
+    ~ExceptionWithReason() override;
 };
 
+// Used instead of throw when exceptions are disabled
+[[noreturn]] void terminateWithException(ExceptionWithReason&& exception) noexcept;
+
 } // namespace MyStd
 
 #endif // EXCEPTIONS_HPP
\ No newline at end of file
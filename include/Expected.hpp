@@ -0,0 +1,77 @@
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include "Errors.hpp"
+
+namespace MyStd
+{
+
+// Value or error code, returned by the non-throwing try* operations. Expected<T&> refers to an element.
+template<typename T>
+class Expected final
+{
+    using Storage = std::conditional_t<std::is_reference<T>::value, std::remove_reference_t<T>*, T>;
+
+    static_assert(std::is_default_constructible<Storage>::value, "value must be default constructible");
+
+    Storage value_;
+    StdErrors error_;
+
+public:
+    Expected(StdErrors error) noexcept : value_(), error_(error) {}
+    Expected(T value) noexcept(std::is_nothrow_copy_constructible<Storage>::value);
+
+    bool hasValue() const noexcept;
+    explicit operator bool() const noexcept;
+
+    StdErrors error() const noexcept;
+
+    // Only when hasValue()
+    T value() const noexcept(std::is_reference<T>::value || std::is_nothrow_copy_constructible<T>::value);
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T>
+Expected<T>::Expected(T value) noexcept(std::is_nothrow_copy_constructible<Storage>::value) :
+    value_(), error_(StdErrors::Ok)
+{
+    if constexpr (std::is_reference<T>::value)
+        value_ = &value;
+    else
+        value_ = std::move(value);
+}
+
+template<typename T>
+bool Expected<T>::hasValue() const noexcept
+{
+    return error_ == StdErrors::Ok;
+}
+
+template<typename T>
+Expected<T>::operator bool() const noexcept
+{
+    return hasValue();
+}
+
+template<typename T>
+StdErrors Expected<T>::error() const noexcept
+{
+    return error_;
+}
+
+template<typename T>
+T Expected<T>::value() const noexcept(std::is_reference<T>::value || std::is_nothrow_copy_constructible<T>::value)
+{
+    if constexpr (std::is_reference<T>::value)
+        return *value_;
+    else
+        return value_;
+}
+
+} // namespace MyStd
+
+#endif // EXPECTED_HPP
@@ -0,0 +1,74 @@
+#ifndef PARALLEL_BUFFER_RECLAIMER_HPP
+#define PARALLEL_BUFFER_RECLAIMER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace MyStd
+{
+
+// Background thread that frees retired buffers, so giving back gigabytes of pages doesn't stall the caller.
+// Queue depth is bounded: when it is full the buffer is freed right in the retiring thread
+class BufferReclaimer final
+{
+public:
+    static constexpr size_t defaultQueueDepth = 64;
+
+    explicit BufferReclaimer(size_t queueDepth = defaultQueueDepth);
+
+    BufferReclaimer(const BufferReclaimer& other) = delete;
+    BufferReclaimer& operator=(const BufferReclaimer& other) = delete;
+
+    // Frees whatever is still queued
+    ~BufferReclaimer();
+
+    size_t queueDepth() const noexcept;
+
+    // Buffers freed by the background thread so far, not counting ones freed by callers on a full queue
+    size_t reclaimedCount() const;
+
+    // Takes ownership of buffer allocated with new char[]
+    void retire(char* buffer) noexcept;
+
+    // Returns once every buffer retired before the call is freed
+    void flush();
+
+    // Never destroyed, allocators inside static objects may still retire buffers at exit
+    static BufferReclaimer& defaultReclaimer();
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable hasWork_;
+    std::condition_variable drained_;
+
+    std::deque<char*> buffers_;
+    size_t queueDepth_;
+    size_t reclaimed_;
+    bool busy_;
+    bool stop_;
+
+    std::thread thread_;
+
+    void reclaimLoop();
+};
+
+// DynamicAllocator release policy: buffers of at least thresholdBytes go to the default reclaimer.
+// Elements are still destroyed by the caller, only the memory itself is freed in the background
+template<size_t thresholdBytes = (size_t(1) << 20)>
+struct DeferredRelease
+{
+    static void release(char* buffer, size_t bytes) noexcept
+    {
+        if (bytes >= thresholdBytes)
+            BufferReclaimer::defaultReclaimer().retire(buffer);
+        else
+            delete [] buffer;
+    }
+};
+
+} // namespace MyStd
+
+#endif // PARALLEL_BUFFER_RECLAIMER_HPP
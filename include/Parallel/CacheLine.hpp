@@ -0,0 +1,28 @@
+#ifndef PARALLEL_CACHE_LINE_HPP
+#define PARALLEL_CACHE_LINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MyStd
+{
+
+constexpr size_t cacheLineSize = 64;
+
+inline size_t alignUp(size_t value, size_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Number of elements of size elemSize to skip from ptr so that the next element starts on a cache line
+inline size_t elementsToCacheLine(const void* ptr, size_t elemSize) noexcept
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    uintptr_t aligned = alignUp(address, cacheLineSize);
+
+    return (aligned - address + elemSize - 1) / elemSize;
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_CACHE_LINE_HPP
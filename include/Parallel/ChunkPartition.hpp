@@ -0,0 +1,68 @@
+#ifndef PARALLEL_CHUNK_PARTITION_HPP
+#define PARALLEL_CHUNK_PARTITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include "Parallel/CacheLine.hpp"
+
+namespace MyStd
+{
+
+// Splits [0, size) into chunks whose inner boundaries are multiples of unit after the first head elements.
+// With head = elementsToCacheLine(data) and unit = elements per cache line no two chunks share a line.
+class ChunkPartition final
+{
+    size_t size_;
+    size_t head_;
+    size_t chunkSize_;
+    size_t chunksCount_;
+
+public:
+    static constexpr size_t minChunkSize    = 4096;
+    static constexpr size_t chunksPerThread = 4;
+
+    ChunkPartition(size_t size, size_t threadsCount, size_t unit, size_t head = 0) noexcept;
+
+    size_t chunksCount() const noexcept;
+
+    size_t begin(size_t chunkId) const noexcept;
+    size_t end  (size_t chunkId) const noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+inline ChunkPartition::ChunkPartition(size_t size, size_t threadsCount, size_t unit, size_t head) noexcept :
+    size_(size), head_(std::min(head, size)), chunkSize_(0), chunksCount_(0)
+{
+    unit = std::max<size_t>(unit, 1);
+
+    size_t targetChunks = std::max<size_t>(threadsCount, 1) * chunksPerThread;
+    chunkSize_ = std::max((size + targetChunks - 1) / targetChunks, minChunkSize);
+    chunkSize_ = alignUp(chunkSize_, unit);
+
+    size_t firstEnd = std::min(size_, head_ + chunkSize_);
+    chunksCount_ = 1 + (size_ - firstEnd + chunkSize_ - 1) / chunkSize_;
+}
+
+inline size_t ChunkPartition::chunksCount() const noexcept
+{
+    return chunksCount_;
+}
+
+inline size_t ChunkPartition::begin(size_t chunkId) const noexcept
+{
+    if (chunkId == 0)
+        return 0;
+
+    return std::min(size_, head_ + chunkId * chunkSize_);
+}
+
+inline size_t ChunkPartition::end(size_t chunkId) const noexcept
+{
+    return begin(chunkId + 1);
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_CHUNK_PARTITION_HPP
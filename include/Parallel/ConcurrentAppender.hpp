@@ -0,0 +1,151 @@
+#ifndef PARALLEL_CONCURRENT_APPENDER_HPP
+#define PARALLEL_CONCURRENT_APPENDER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "Parallel/CacheLine.hpp"
+
+namespace MyStd
+{
+
+// Lock free parallel fill of one contiguous Vector with a known upper bound on the number of new elements.
+// Writers claim index ranges with a single fetch_add, write the elements in place and publish them.
+// Publication is ordered: a range becomes visible after every range claimed before it, so readers always
+// see a contiguous committed prefix. Vector itself is not touched until finish(), readers go through data().
+//
+// Trivially copyable T only, claimed slots are raw reserved capacity. Once a claim fails for lack of room
+// every later claim fails too
+template<typename T, typename Allocator = DynamicAllocator<T> >
+class ConcurrentAppender final
+{
+    static_assert(std::is_trivially_copyable<T>::value, "claimed slots are written as raw memory");
+
+    struct alignas(cacheLineSize) Counter
+    {
+        std::atomic<size_t> value;
+
+        explicit Counter(size_t start) noexcept : value(start) {}
+    };
+
+    Vector<T, Allocator>& vector_;
+    T* data_;
+    size_t limit_;
+
+    Counter claimed_;
+    Counter committed_;
+
+    bool finished_;
+
+public:
+    static constexpr size_t noRoom = static_cast<size_t>(-1);
+
+    // Reserves room for maxCount elements after the current ones
+    ConcurrentAppender(Vector<T, Allocator>& vector, size_t maxCount);
+
+    ConcurrentAppender(const ConcurrentAppender& other) = delete;
+    ConcurrentAppender& operator=(const ConcurrentAppender& other) = delete;
+
+    // Same as finish() unless it was already called
+    ~ConcurrentAppender();
+
+    // Index of the first of count claimed slots, noRoom if they don't fit
+    size_t claim(size_t count) noexcept;
+
+    // Makes claimed slots [begin, begin + count) visible. Waits for ranges claimed earlier to be published,
+    // so every successful claim must be published, even with nothing written into it
+    void publish(size_t begin, size_t count) noexcept;
+
+    // Elements [0, committed()) may be read, including those vector had before
+    size_t committed() const noexcept;
+    void   waitForCommitted(size_t count) const noexcept;
+
+    T*       data() noexcept;
+    const T* data() const noexcept;
+
+    // Vector takes the committed prefix as its size. Writers must be done, unpublished claims are dropped.
+    // Only the first call does anything, the vector belongs to the caller again afterwards
+    void finish();
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator>
+ConcurrentAppender<T, Allocator>::ConcurrentAppender(Vector<T, Allocator>& vector, size_t maxCount) :
+    vector_(vector), data_(nullptr), limit_(vector.size() + maxCount),
+    claimed_(vector.size()), committed_(vector.size()), finished_(false)
+{
+    vector_.reserve(limit_);
+    data_ = vector_.data();
+}
+
+template<typename T, typename Allocator>
+ConcurrentAppender<T, Allocator>::~ConcurrentAppender()
+{
+    finish();
+}
+
+template<typename T, typename Allocator>
+size_t ConcurrentAppender<T, Allocator>::claim(size_t count) noexcept
+{
+    // Relaxed: the range is private to the writer until publish
+    size_t begin = claimed_.value.fetch_add(count, std::memory_order_relaxed);
+
+    if (begin > limit_ || count > limit_ - begin)
+        return noRoom;
+
+    return begin;
+}
+
+template<typename T, typename Allocator>
+void ConcurrentAppender<T, Allocator>::publish(size_t begin, size_t count) noexcept
+{
+    while (committed_.value.load(std::memory_order_acquire) != begin)
+        std::this_thread::yield();
+
+    committed_.value.store(begin + count, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+size_t ConcurrentAppender<T, Allocator>::committed() const noexcept
+{
+    return committed_.value.load(std::memory_order_acquire);
+}
+
+template<typename T, typename Allocator>
+void ConcurrentAppender<T, Allocator>::waitForCommitted(size_t count) const noexcept
+{
+    while (committed() < count)
+        std::this_thread::yield();
+}
+
+template<typename T, typename Allocator>
+T* ConcurrentAppender<T, Allocator>::data() noexcept
+{
+    return data_;
+}
+
+template<typename T, typename Allocator>
+const T* ConcurrentAppender<T, Allocator>::data() const noexcept
+{
+    return data_;
+}
+
+template<typename T, typename Allocator>
+void ConcurrentAppender<T, Allocator>::finish()
+{
+    if (finished_)
+        return;
+
+    finished_ = true;
+
+    // Capacity is already there, this only moves the size
+    vector_.resizeUninitialized(committed());
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_CONCURRENT_APPENDER_HPP
@@ -0,0 +1,435 @@
+#ifndef PARALLEL_PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_PARALLEL_ALGORITHMS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Parallel/CacheLine.hpp"
+#include "Parallel/ChunkPartition.hpp"
+#include "Parallel/ThreadPool.hpp"
+
+namespace MyStd
+{
+
+// T may be const, only parallelForEach and parallelReduce accept read only views
+template<typename T, typename Func>
+void parallelForEach(VectorView<T> view, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+// In place: view[i] = func(view[i])
+template<typename T, typename Func>
+void parallelTransform(VectorView<T> view, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+// Views must have the same size: dst[i] = func(src[i])
+template<typename T, typename U, typename Func>
+void parallelTransform(
+    VectorView<T> src, VectorView<U> dst, Func func, ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+// Elements are converted to U, op must be associative. Chunks are combined left to right starting from init
+template<typename T, typename U, typename BinaryOp>
+U parallelReduce(VectorView<T> view, U init, BinaryOp op, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T>
+void parallelFill(VectorView<T> view, const T& value, ThreadPool& pool = ThreadPool::defaultPool());
+
+// Vector overloads
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEach(Vector<T, Allocator>& vector, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEach(const Vector<T, Allocator>& vector, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename Func>
+void parallelTransform(Vector<T, Allocator>& vector, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+// dst is resized to src.size(), then dst[i] = func(src[i])
+template<typename T, typename SrcAllocator, typename U, typename DstAllocator, typename Func>
+void parallelTransform(
+    const Vector<T, SrcAllocator>& src, Vector<U, DstAllocator>& dst, Func func,
+    ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+template<typename T, typename Allocator, typename U, typename BinaryOp>
+U parallelReduce(
+    const Vector<T, Allocator>& vector, U init, BinaryOp op, ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+template<typename T, typename Allocator>
+void parallelFill(Vector<T, Allocator>& vector, const T& value, ThreadPool& pool = ThreadPool::defaultPool());
+
+// First-touch construction: new elements are filled chunk by chunk from the pool threads instead of the caller,
+// so the pages of a huge vector are spread over the nodes the workers run on and filling scales with cores.
+// Only trivially copyable T, their construction is the fill itself. Shrinking works like resize
+template<typename T, typename Allocator>
+void parallelResize(
+    Vector<T, Allocator>& vector, size_t newSize, const T& value, ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+template<typename T, typename Allocator = DynamicAllocator<T> >
+Vector<T, Allocator> parallelConstruct(size_t size, const T& value, ThreadPool& pool = ThreadPool::defaultPool());
+
+// Bit chunks start on 64-bit aligned words of memory, whatever bit a subview starts at, so two threads never
+// write the same byte or share a word
+
+template<typename Byte, typename Func>
+void parallelForEach(BasicBitView<Byte> view, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Func>
+void parallelTransform(BitView view, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Byte, typename U, typename BinaryOp>
+U parallelReduce(BasicBitView<Byte> view, U init, BinaryOp op, ThreadPool& pool = ThreadPool::defaultPool());
+
+inline void parallelFill(BitView view, const bool value, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Allocator, typename Func>
+void parallelForEach(const Vector<bool, Allocator>& vector, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Allocator, typename Func>
+void parallelForEach(Vector<bool, Allocator>& vector, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Allocator, typename Func>
+void parallelTransform(Vector<bool, Allocator>& vector, Func func, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Allocator, typename U, typename BinaryOp>
+U parallelReduce(
+    const Vector<bool, Allocator>& vector, U init, BinaryOp op, ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+template<typename Allocator>
+void parallelFill(Vector<bool, Allocator>& vector, const bool value, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename Allocator>
+void parallelResize(
+    Vector<bool, Allocator>& vector, size_t newSize, const bool value, ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+// --------------------------Implementation-----------------------------------
+
+namespace
+{
+
+const size_t bitsInWord = 64;
+
+template<typename T>
+struct alignas(cacheLineSize) PaddedValue
+{
+    T value;
+};
+
+template<typename T>
+ChunkPartition makeElementsPartition(const T* data, size_t size, const ThreadPool& pool) noexcept
+{
+    size_t elementsInLine = std::max<size_t>(cacheLineSize / sizeof(T), 1);
+    return ChunkPartition{size, pool.threadsCount(), elementsInLine, elementsToCacheLine(data, sizeof(T))};
+}
+
+// First chunk ends where the next 8-byte aligned word of memory begins
+inline ChunkPartition makeBitsPartition(const uint8_t* data, size_t size, size_t bitOffset, const ThreadPool& pool)
+    noexcept
+{
+    size_t bitInWord = (reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t)) * __CHAR_BIT__ + bitOffset;
+
+    return ChunkPartition{size, pool.threadsCount(), bitsInWord, (bitsInWord - bitInWord % bitsInWord) % bitsInWord};
+}
+
+} // namespace anon
+
+template<typename T, typename Func>
+void parallelForEach(VectorView<T> view, Func func, ThreadPool& pool)
+{
+    T* data = view.data();
+    ChunkPartition partition = makeElementsPartition(data, view.size(), pool);
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        for (size_t i = partition.begin(chunkId), end = partition.end(chunkId); i < end; ++i)
+            func(data[i]);
+    });
+}
+
+template<typename T, typename Func>
+void parallelTransform(VectorView<T> view, Func func, ThreadPool& pool)
+{
+    parallelForEach(view, [&func](T& value) { value = func(value); }, pool);
+}
+
+template<typename T, typename U, typename Func>
+void parallelTransform(VectorView<T> src, VectorView<U> dst, Func func, ThreadPool& pool)
+{
+    if (src.size() != dst.size())
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorSizeMismatch,
+            "Views passed to parallel transform have different sizes",
+            {}
+        );
+    }
+
+    T* srcData = src.data();
+    U* dstData = dst.data();
+
+    ChunkPartition partition = makeElementsPartition(dstData, dst.size(), pool);
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        for (size_t i = partition.begin(chunkId), end = partition.end(chunkId); i < end; ++i)
+            dstData[i] = func(srcData[i]);
+    });
+}
+
+template<typename T, typename U, typename BinaryOp>
+U parallelReduce(VectorView<T> view, U init, BinaryOp op, ThreadPool& pool)
+{
+    if (view.empty())
+        return init;
+
+    T* data = view.data();
+    ChunkPartition partition = makeElementsPartition(data, view.size(), pool);
+
+    std::vector<PaddedValue<U> > partials(partition.chunksCount());
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        size_t begin = partition.begin(chunkId);
+        size_t end   = partition.end(chunkId);
+
+        U partial = static_cast<U>(data[begin]);
+        for (size_t i = begin + 1; i < end; ++i)
+            partial = op(partial, data[i]);
+
+        partials[chunkId].value = partial;
+    });
+
+    U result = init;
+    for (size_t chunkId = 0; chunkId < partials.size(); ++chunkId)
+        result = op(result, partials[chunkId].value);
+
+    return result;
+}
+
+template<typename T>
+void parallelFill(VectorView<T> view, const T& value, ThreadPool& pool)
+{
+    parallelForEach(view, [&value](T& element) { element = value; }, pool);
+}
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEach(Vector<T, Allocator>& vector, Func func, ThreadPool& pool)
+{
+    parallelForEach(VectorView<T>{vector}, func, pool);
+}
+
+template<typename T, typename Allocator, typename Func>
+void parallelForEach(const Vector<T, Allocator>& vector, Func func, ThreadPool& pool)
+{
+    parallelForEach(VectorView<const T>{vector}, func, pool);
+}
+
+template<typename T, typename Allocator, typename Func>
+void parallelTransform(Vector<T, Allocator>& vector, Func func, ThreadPool& pool)
+{
+    parallelTransform(VectorView<T>{vector}, func, pool);
+}
+
+template<typename T, typename SrcAllocator, typename U, typename DstAllocator, typename Func>
+void parallelTransform(
+    const Vector<T, SrcAllocator>& src, Vector<U, DstAllocator>& dst, Func func, ThreadPool& pool
+)
+{
+    if (dst.size() != src.size())
+        dst.resize(src.size());
+
+    parallelTransform(VectorView<const T>{src}, VectorView<U>{dst}, func, pool);
+}
+
+template<typename T, typename Allocator, typename U, typename BinaryOp>
+U parallelReduce(const Vector<T, Allocator>& vector, U init, BinaryOp op, ThreadPool& pool)
+{
+    return parallelReduce(VectorView<const T>{vector}, init, op, pool);
+}
+
+template<typename T, typename Allocator>
+void parallelFill(Vector<T, Allocator>& vector, const T& value, ThreadPool& pool)
+{
+    parallelFill(VectorView<T>{vector}, value, pool);
+}
+
+template<typename T, typename Allocator>
+void parallelResize(Vector<T, Allocator>& vector, size_t newSize, const T& value, ThreadPool& pool)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "parallel construction is allowed only for trivial types");
+
+    size_t oldSize = vector.size();
+
+    if (newSize <= oldSize)
+    {
+        vector.resize(newSize, value);
+        return;
+    }
+
+    // value may be one of our own elements
+    T fillValue{value};
+
+    // Fresh buffer isn't touched before the fill, only the old elements are copied into it
+    vector.resizeUninitialized(newSize);
+
+    parallelFill(VectorView<T>{vector}.subview(oldSize), fillValue, pool);
+}
+
+template<typename T, typename Allocator>
+Vector<T, Allocator> parallelConstruct(size_t size, const T& value, ThreadPool& pool)
+{
+    Vector<T, Allocator> vector;
+    parallelResize(vector, size, value, pool);
+
+    return vector;
+}
+
+template<typename Byte, typename Func>
+void parallelForEach(BasicBitView<Byte> view, Func func, ThreadPool& pool)
+{
+    const uint8_t* data = view.data();
+    size_t offset = view.bitOffset();
+
+    ChunkPartition partition = makeBitsPartition(data, view.size(), offset, pool);
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        for (size_t i = partition.begin(chunkId), end = partition.end(chunkId); i < end; ++i)
+            func(getBit(data, offset + i));
+    });
+}
+
+template<typename Func>
+void parallelTransform(BitView view, Func func, ThreadPool& pool)
+{
+    uint8_t* data = view.data();
+    size_t offset = view.bitOffset();
+
+    ChunkPartition partition = makeBitsPartition(data, view.size(), offset, pool);
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        for (size_t i = offset + partition.begin(chunkId), end = offset + partition.end(chunkId); i < end; ++i)
+            setBit(data, i, func(getBit(data, i)));
+    });
+}
+
+template<typename Byte, typename U, typename BinaryOp>
+U parallelReduce(BasicBitView<Byte> view, U init, BinaryOp op, ThreadPool& pool)
+{
+    if (view.empty())
+        return init;
+
+    const uint8_t* data = view.data();
+    size_t offset = view.bitOffset();
+
+    ChunkPartition partition = makeBitsPartition(data, view.size(), offset, pool);
+
+    std::vector<PaddedValue<U> > partials(partition.chunksCount());
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        size_t begin = offset + partition.begin(chunkId);
+        size_t end   = offset + partition.end(chunkId);
+
+        U partial = static_cast<U>(getBit(data, begin));
+        for (size_t i = begin + 1; i < end; ++i)
+            partial = op(partial, getBit(data, i));
+
+        partials[chunkId].value = partial;
+    });
+
+    U result = init;
+    for (size_t chunkId = 0; chunkId < partials.size(); ++chunkId)
+        result = op(result, partials[chunkId].value);
+
+    return result;
+}
+
+inline void parallelFill(BitView view, const bool value, ThreadPool& pool)
+{
+    uint8_t* data = view.data();
+    size_t offset = view.bitOffset();
+
+    ChunkPartition partition = makeBitsPartition(data, view.size(), offset, pool);
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        size_t begin = offset + partition.begin(chunkId);
+        size_t end   = offset + partition.end(chunkId);
+
+        // Partial bytes at both ends go bit by bit, whole bytes between them at once
+        size_t fullBlocksBegin = getBlock(begin + __CHAR_BIT__ - 1);
+        size_t fullBlocksEnd   = getBlock(end);
+
+        if (fullBlocksEnd <= fullBlocksBegin)
+        {
+            for (size_t i = begin; i < end; ++i)
+                setBit(data, i, value);
+
+            return;
+        }
+
+        for (size_t i = begin; i < fullBlocksBegin * __CHAR_BIT__; ++i)
+            setBit(data, i, value);
+
+        memset(data + fullBlocksBegin, value ? 0xFF : 0, fullBlocksEnd - fullBlocksBegin);
+
+        for (size_t i = fullBlocksEnd * __CHAR_BIT__; i < end; ++i)
+            setBit(data, i, value);
+    });
+}
+
+template<typename Allocator, typename Func>
+void parallelForEach(const Vector<bool, Allocator>& vector, Func func, ThreadPool& pool)
+{
+    parallelForEach(ConstBitView{vector}, func, pool);
+}
+
+template<typename Allocator, typename Func>
+void parallelForEach(Vector<bool, Allocator>& vector, Func func, ThreadPool& pool)
+{
+    parallelForEach(ConstBitView{vector}, func, pool);
+}
+
+template<typename Allocator, typename Func>
+void parallelTransform(Vector<bool, Allocator>& vector, Func func, ThreadPool& pool)
+{
+    parallelTransform(BitView{vector}, func, pool);
+}
+
+template<typename Allocator, typename U, typename BinaryOp>
+U parallelReduce(const Vector<bool, Allocator>& vector, U init, BinaryOp op, ThreadPool& pool)
+{
+    return parallelReduce(ConstBitView{vector}, init, op, pool);
+}
+
+template<typename Allocator>
+void parallelFill(Vector<bool, Allocator>& vector, const bool value, ThreadPool& pool)
+{
+    parallelFill(BitView{vector}, value, pool);
+}
+
+template<typename Allocator>
+void parallelResize(Vector<bool, Allocator>& vector, size_t newSize, const bool value, ThreadPool& pool)
+{
+    size_t oldSize = vector.size();
+
+    // Also drops the tail when shrinking, there are no destructors to run for bits
+    vector.resizeUninitialized(newSize);
+
+    if (newSize > oldSize)
+        parallelFill(BitView{vector}.subview(oldSize), value, pool);
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_PARALLEL_ALGORITHMS_HPP
@@ -0,0 +1,429 @@
+#ifndef PARALLEL_PARALLEL_SORT_HPP
+#define PARALLEL_PARALLEL_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Parallel/ChunkPartition.hpp"
+#include "Parallel/ThreadPool.hpp"
+
+namespace MyStd
+{
+
+// Arithmetic elements without a comparator go through LSD radix sort, which is stable, so sort and stableSort
+// are the same for them. Floats are ordered by value, -0.0 before 0.0, NaNs at the ends by their sign.
+// Everything else is a parallel merge sort: chunks are sorted on the pool, then merged pairwise, every
+// merge split between threads. Both need a scratch buffer of size() elements, non trivial T must be
+// default constructible for it. Vector<bool> holds packed bits and can't be sorted in place.
+
+template<typename T>
+void sort(VectorView<T> view, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Compare>
+void sort(VectorView<T> view, Compare less, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T>
+void stableSort(VectorView<T> view, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Compare>
+void stableSort(VectorView<T> view, Compare less, ThreadPool& pool = ThreadPool::defaultPool());
+
+// Stable radix sort by key(element), key must return integral or floating point value
+template<typename T, typename KeyFunc>
+void sortByKey(VectorView<T> view, KeyFunc key, ThreadPool& pool = ThreadPool::defaultPool());
+
+// Vector overloads, scratch is allocated by the vector's allocator type
+
+template<typename T, typename Allocator>
+void sort(Vector<T, Allocator>& vector, ThreadPool& pool = ThreadPool::defaultPool());
+
+// scratch keeps its capacity between calls, so sorting batch after batch allocates only once
+template<typename T, typename Allocator>
+void sort(Vector<T, Allocator>& vector, Vector<T, Allocator>& scratch, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename Compare>
+void sort(Vector<T, Allocator>& vector, Compare less, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator>
+void stableSort(Vector<T, Allocator>& vector, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename Compare>
+void stableSort(Vector<T, Allocator>& vector, Compare less, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename KeyFunc>
+void sortByKey(Vector<T, Allocator>& vector, KeyFunc key, ThreadPool& pool = ThreadPool::defaultPool());
+
+template<typename T, typename Allocator, typename KeyFunc>
+void sortByKey(
+    Vector<T, Allocator>& vector, KeyFunc key, Vector<T, Allocator>& scratch,
+    ThreadPool& pool = ThreadPool::defaultPool()
+);
+
+// --------------------------Implementation-----------------------------------
+
+namespace
+{
+
+// Below this radix passes cost more than they save
+const size_t radixSortMinSize = 4096;
+const size_t radixBuckets     = 256;
+
+template<typename Key>
+using RadixBits = std::conditional_t<sizeof(Key) == 1, uint8_t,
+                  std::conditional_t<sizeof(Key) == 2, uint16_t,
+                  std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t> > >;
+
+// Maps key to unsigned bits that compare in the same order
+template<typename Key>
+RadixBits<Key> toRadixKey(Key key) noexcept
+{
+    static_assert(std::is_arithmetic<Key>::value && sizeof(Key) <= 8, "radix key must be an integer or a float");
+
+    using Bits = RadixBits<Key>;
+
+    Bits bits = 0;
+    memcpy(&bits, &key, sizeof(key));
+
+    const Bits signBit = static_cast<Bits>(Bits(1) << (8 * sizeof(Bits) - 1));
+
+    if constexpr (std::is_floating_point<Key>::value)
+        return (bits & signBit) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | signBit);
+    else if constexpr (std::is_signed<Key>::value)
+        return static_cast<Bits>(bits ^ signBit);
+    else
+        return bits;
+}
+
+template<typename T, typename Allocator>
+T* prepareSortScratch(Vector<T, Allocator>& scratch, size_t size)
+{
+    if (scratch.size() >= size)
+        return scratch.data();
+
+    if constexpr (std::is_trivially_copyable<T>::value)
+        scratch.resizeUninitialized(size);
+    else
+        scratch.resize(size);
+
+    return scratch.data();
+}
+
+template<typename T>
+void copySortedBack(T* data, const T* from, size_t size, ThreadPool& pool)
+{
+    ChunkPartition partition{size, pool.threadsCount(), 1};
+
+    pool.parallelFor(partition.chunksCount(), [&](size_t chunkId)
+    {
+        std::copy(from + partition.begin(chunkId), from + partition.end(chunkId), data + partition.begin(chunkId));
+    });
+}
+
+template<typename T, typename ScratchVector, typename KeyFunc>
+void sortByRadixKey(T* data, size_t size, ScratchVector& scratch, KeyFunc& key, ThreadPool& pool)
+{
+    using Bits = decltype(toRadixKey(key(*data)));
+
+    if (size < radixSortMinSize)
+    {
+        std::stable_sort(data, data + size, [&key](const T& lhs, const T& rhs)
+        {
+            return toRadixKey(key(lhs)) < toRadixKey(key(rhs));
+        });
+
+        return;
+    }
+
+    T* src = data;
+    T* dst = prepareSortScratch(scratch, size);
+
+    ChunkPartition partition{size, pool.threadsCount(), 1};
+    size_t chunksCount = partition.chunksCount();
+
+    // counts[chunk * radixBuckets + bucket], turned into the chunk's first output position for the bucket
+    Vector<size_t> counts(chunksCount * radixBuckets, 0);
+
+    for (size_t shift = 0; shift < 8 * sizeof(Bits); shift += 8)
+    {
+        std::fill(counts.data(), counts.data() + counts.size(), 0);
+
+        pool.parallelFor(chunksCount, [&](size_t chunkId)
+        {
+            size_t* chunkCounts = counts.data() + chunkId * radixBuckets;
+
+            for (size_t i = partition.begin(chunkId), end = partition.end(chunkId); i < end; ++i)
+                ++chunkCounts[(toRadixKey(key(src[i])) >> shift) & (radixBuckets - 1)];
+        });
+
+        size_t offset = 0;
+        bool   skipPass = false;
+
+        for (size_t bucket = 0; bucket < radixBuckets; ++bucket)
+        {
+            size_t bucketBegin = offset;
+
+            for (size_t chunkId = 0; chunkId < chunksCount; ++chunkId)
+            {
+                size_t count = counts[chunkId * radixBuckets + bucket];
+                counts[chunkId * radixBuckets + bucket] = offset;
+                offset += count;
+            }
+
+            // All elements have the same digit, e.g. high bytes of small numbers: the pass wouldn't move anything
+            if (offset - bucketBegin == size)
+                skipPass = true;
+        }
+
+        if (skipPass)
+            continue;
+
+        pool.parallelFor(chunksCount, [&](size_t chunkId)
+        {
+            size_t* chunkOffsets = counts.data() + chunkId * radixBuckets;
+
+            for (size_t i = partition.begin(chunkId), end = partition.end(chunkId); i < end; ++i)
+                dst[chunkOffsets[(toRadixKey(key(src[i])) >> shift) & (radixBuckets - 1)]++] = src[i];
+        });
+
+        std::swap(src, dst);
+    }
+
+    if (src != data)
+        copySortedBack(data, src, size, pool);
+}
+
+struct SortMergePiece
+{
+    size_t begin;  // first run is [begin, middle), second is [middle, end)
+    size_t middle;
+    size_t end;
+    size_t from;   // output range of this piece, inside [begin, end)
+    size_t to;
+};
+
+// Number of elements taken from a when the first outputCount elements of merge(a, b) are written.
+// Equal elements are taken from a first, like std::merge does
+template<typename T, typename Compare>
+size_t mergeCoRank(size_t outputCount, const T* a, size_t aSize, const T* b, size_t bSize, Compare& less)
+{
+    size_t low  = outputCount > bSize ? outputCount - bSize : 0;
+    size_t high = std::min(outputCount, aSize);
+
+    while (low < high)
+    {
+        size_t taken = low + (high - low) / 2;
+        size_t takenFromB = outputCount - taken;
+
+        if (takenFromB == 0 || less(b[takenFromB - 1], a[taken]))
+            high = taken;
+        else
+            low = taken + 1;
+    }
+
+    return low;
+}
+
+template<typename T, typename ScratchVector, typename Compare>
+void sortByMerging(T* data, size_t size, ScratchVector& scratch, Compare& less, bool stable, ThreadPool& pool)
+{
+    ChunkPartition partition{size, pool.threadsCount(), 1};
+    size_t chunksCount = partition.chunksCount();
+
+    pool.parallelFor(chunksCount, [&](size_t chunkId)
+    {
+        T* begin = data + partition.begin(chunkId);
+        T* end   = data + partition.end(chunkId);
+
+        if (stable)
+            std::stable_sort(begin, end, less);
+        else
+            std::sort(begin, end, less);
+    });
+
+    if (chunksCount == 1)
+        return;
+
+    T* src = data;
+    T* dst = prepareSortScratch(scratch, size);
+
+    Vector<size_t> runs;
+    runs.reserve(chunksCount + 1);
+
+    for (size_t chunkId = 0; chunkId <= chunksCount; ++chunkId)
+        runs.pushBack(partition.begin(chunkId));
+
+    // Pieces are about a chunk long, so every round keeps all threads busy, the last one too
+    size_t pieceSize = partition.end(0);
+
+    Vector<SortMergePiece> pieces;
+    Vector<size_t> mergedRuns;
+
+    while (runs.size() > 2)
+    {
+        size_t runsCount = runs.size() - 1;
+
+        pieces.clear();
+        mergedRuns.clear();
+
+        for (size_t run = 0; run < runsCount; run += 2)
+        {
+            size_t begin  = runs[run];
+            size_t middle = runs[run + 1];
+            size_t end    = run + 2 <= runsCount ? runs[run + 2] : middle; // odd run out is just copied
+
+            for (size_t from = begin; from < end; from += pieceSize)
+                pieces.pushBack({begin, middle, end, from, std::min(from + pieceSize, end)});
+
+            mergedRuns.pushBack(begin);
+        }
+
+        mergedRuns.pushBack(size);
+
+        pool.parallelFor(pieces.size(), [&](size_t pieceId)
+        {
+            const SortMergePiece& piece = pieces[pieceId];
+
+            const T* a = src + piece.begin;
+            const T* b = src + piece.middle;
+            size_t aSize = piece.middle - piece.begin;
+            size_t bSize = piece.end    - piece.middle;
+
+            size_t from = piece.from - piece.begin;
+            size_t to   = piece.to   - piece.begin;
+
+            size_t aFrom = mergeCoRank(from, a, aSize, b, bSize, less);
+            size_t aTo   = mergeCoRank(to,   a, aSize, b, bSize, less);
+
+            std::merge(a + aFrom, a + aTo, b + (from - aFrom), b + (to - aTo), dst + piece.from, less);
+        });
+
+        std::swap(src, dst);
+        runs.swap(mergedRuns);
+    }
+
+    if (src != data)
+        copySortedBack(data, src, size, pool);
+}
+
+template<typename T, typename ScratchVector>
+void sortWithDefaultOrder(T* data, size_t size, ScratchVector& scratch, bool stable, ThreadPool& pool)
+{
+    if constexpr (std::is_arithmetic<T>::value)
+    {
+        auto identity = [](const T& value) { return value; };
+        sortByRadixKey(data, size, scratch, identity, pool);
+    }
+    else
+    {
+        std::less<T> less;
+        sortByMerging(data, size, scratch, less, stable, pool);
+    }
+}
+
+} // namespace anon
+
+template<typename T>
+void sort(VectorView<T> view, ThreadPool& pool)
+{
+    Vector<T> scratch;
+    sortWithDefaultOrder(view.data(), view.size(), scratch, false, pool);
+}
+
+template<typename T, typename Compare>
+void sort(VectorView<T> view, Compare less, ThreadPool& pool)
+{
+    Vector<T> scratch;
+    sortByMerging(view.data(), view.size(), scratch, less, false, pool);
+}
+
+template<typename T>
+void stableSort(VectorView<T> view, ThreadPool& pool)
+{
+    Vector<T> scratch;
+    sortWithDefaultOrder(view.data(), view.size(), scratch, true, pool);
+}
+
+template<typename T, typename Compare>
+void stableSort(VectorView<T> view, Compare less, ThreadPool& pool)
+{
+    Vector<T> scratch;
+    sortByMerging(view.data(), view.size(), scratch, less, true, pool);
+}
+
+template<typename T, typename KeyFunc>
+void sortByKey(VectorView<T> view, KeyFunc key, ThreadPool& pool)
+{
+    Vector<T> scratch;
+    sortByRadixKey(view.data(), view.size(), scratch, key, pool);
+}
+
+template<typename T, typename Allocator>
+void sort(Vector<T, Allocator>& vector, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    Vector<T, Allocator> scratch;
+    sortWithDefaultOrder(vector.data(), vector.size(), scratch, false, pool);
+}
+
+template<typename T, typename Allocator>
+void sort(Vector<T, Allocator>& vector, Vector<T, Allocator>& scratch, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    sortWithDefaultOrder(vector.data(), vector.size(), scratch, false, pool);
+}
+
+template<typename T, typename Allocator, typename Compare>
+void sort(Vector<T, Allocator>& vector, Compare less, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    Vector<T, Allocator> scratch;
+    sortByMerging(vector.data(), vector.size(), scratch, less, false, pool);
+}
+
+template<typename T, typename Allocator>
+void stableSort(Vector<T, Allocator>& vector, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    Vector<T, Allocator> scratch;
+    sortWithDefaultOrder(vector.data(), vector.size(), scratch, true, pool);
+}
+
+template<typename T, typename Allocator, typename Compare>
+void stableSort(Vector<T, Allocator>& vector, Compare less, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    Vector<T, Allocator> scratch;
+    sortByMerging(vector.data(), vector.size(), scratch, less, true, pool);
+}
+
+template<typename T, typename Allocator, typename KeyFunc>
+void sortByKey(Vector<T, Allocator>& vector, KeyFunc key, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    Vector<T, Allocator> scratch;
+    sortByRadixKey(vector.data(), vector.size(), scratch, key, pool);
+}
+
+template<typename T, typename Allocator, typename KeyFunc>
+void sortByKey(Vector<T, Allocator>& vector, KeyFunc key, Vector<T, Allocator>& scratch, ThreadPool& pool)
+{
+    static_assert(!std::is_same<T, bool>::value, "Vector<bool> stores packed bits, it has no elements to sort");
+
+    sortByRadixKey(vector.data(), vector.size(), scratch, key, pool);
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_PARALLEL_SORT_HPP
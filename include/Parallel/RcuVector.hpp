@@ -0,0 +1,247 @@
+#ifndef PARALLEL_RCU_VECTOR_HPP
+#define PARALLEL_RCU_VECTOR_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "CommonVectorFuncs.hpp"
+#include "Parallel/CacheLine.hpp"
+
+namespace MyStd
+{
+
+// Append only vector for one writer thread and up to maxReaders reader threads. Readers never block:
+// a ReadGuard pins the current buffer and size, and published elements are never written again.
+// Growth copies into a new buffer and swaps the pointer, the old one is retired and freed by the writer
+// once every reader that could have seen it is gone (epoch based reclamation).
+//
+// Reader ids are chosen by the caller like shard ids of ShardedVector, one thread per id at a time.
+// Trivially copyable T only, readers copy elements while the writer appends after them
+template<typename T, typename Allocator = DynamicAllocator<T> >
+class RcuVector final
+{
+    static_assert(std::is_trivially_copyable<T>::value, "readers access elements without synchronization");
+
+    struct Block
+    {
+        Vector<T, Allocator> values;
+
+        Block() : values() {}
+    };
+
+    struct RetiredBlock
+    {
+        Block* block;
+        uint64_t epoch;
+    };
+
+    // 0 while the reader is outside of a guard
+    struct alignas(cacheLineSize) ReaderSlot
+    {
+        std::atomic<uint64_t> epoch;
+
+        ReaderSlot() noexcept : epoch(0) {}
+    };
+
+    static constexpr uint64_t inactive = 0;
+
+    alignas(cacheLineSize) std::atomic<Block*> block_;
+    std::atomic<size_t> size_;
+    std::atomic<uint64_t> epoch_;
+
+    std::unique_ptr<ReaderSlot[]> readers_;
+    size_t maxReaders_;
+
+    // Writer only
+    Vector<RetiredBlock> retired_;
+
+public:
+    class ReadGuard final
+    {
+        ReaderSlot* slot_;
+        VectorView<const T> view_;
+
+    public:
+        ReadGuard(ReaderSlot* slot, VectorView<const T> view) noexcept : slot_(slot), view_(view) {}
+
+        ReadGuard(const ReadGuard& other) = delete;
+        ReadGuard& operator=(const ReadGuard& other) = delete;
+
+        ReadGuard(ReadGuard&& other) noexcept;
+
+        ~ReadGuard();
+
+        // Everything published when the guard was taken, stays valid while the guard lives
+        VectorView<const T> view() const noexcept { return view_; }
+
+        size_t   size() const noexcept { return view_.size(); }
+        const T& operator[](size_t pos) const noexcept { return view_[pos]; }
+    };
+
+    explicit RcuVector(size_t maxReaders);
+
+    RcuVector(const RcuVector& other) = delete;
+    RcuVector& operator=(const RcuVector& other) = delete;
+
+    // No reader may hold a guard anymore
+    ~RcuVector();
+
+    size_t maxReaders() const noexcept;
+
+    // Reader side, readerId < maxReaders()
+    ReadGuard read(size_t readerId) noexcept;
+
+    // Writer side
+    size_t size() const noexcept;
+
+    void pushBack(const T& value);
+
+    // Frees retired buffers no reader can reach anymore, growth calls it by itself. Returns how many are left
+    size_t reclaim();
+
+private:
+    uint64_t oldestReaderEpoch() const noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator>
+RcuVector<T, Allocator>::ReadGuard::ReadGuard(ReadGuard&& other) noexcept : slot_(other.slot_), view_(other.view_)
+{
+    other.slot_ = nullptr;
+}
+
+template<typename T, typename Allocator>
+RcuVector<T, Allocator>::ReadGuard::~ReadGuard()
+{
+    if (slot_)
+        slot_->epoch.store(inactive, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+RcuVector<T, Allocator>::RcuVector(size_t maxReaders) :
+    block_(nullptr), size_(0), epoch_(1), readers_(new ReaderSlot[maxReaders]), maxReaders_(maxReaders), retired_()
+{
+    block_.store(new Block{}, std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+RcuVector<T, Allocator>::~RcuVector()
+{
+    for (size_t pos = 0; pos < retired_.size(); ++pos)
+        delete retired_[pos].block;
+
+    delete block_.load(std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+size_t RcuVector<T, Allocator>::maxReaders() const noexcept
+{
+    return maxReaders_;
+}
+
+template<typename T, typename Allocator>
+typename RcuVector<T, Allocator>::ReadGuard RcuVector<T, Allocator>::read(size_t readerId) noexcept
+{
+    assert(readerId < maxReaders_);
+
+    ReaderSlot* slot = &readers_[readerId];
+
+    // Seq cst: either the writer sees this epoch when it checks readers, or this load sees the new buffer
+    slot->epoch.store(epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+
+    // Size first: a buffer published before the size was stored holds at least that many elements
+    size_t size  = size_.load(std::memory_order_seq_cst);
+    Block* block = block_.load(std::memory_order_seq_cst);
+
+    return ReadGuard{slot, VectorView<const T>{block->values.data(), size}};
+}
+
+template<typename T, typename Allocator>
+size_t RcuVector<T, Allocator>::size() const noexcept
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+void RcuVector<T, Allocator>::pushBack(const T& value)
+{
+    // value may live in the buffer that is about to be retired
+    T copy{value};
+
+    Block* block = block_.load(std::memory_order_relaxed);
+    size_t size  = size_.load(std::memory_order_relaxed);
+
+    if (size == block->values.capacity())
+    {
+        std::unique_ptr<Block> grown{new Block{}};
+        grown->values.reserve(getCapacityAfterGrowth(size));
+        grown->values.resizeUninitialized(size);
+
+        if (size != 0)
+            memcpy(grown->values.data(), block->values.data(), size * sizeof(T));
+
+        // Room for the record before the old buffer becomes unreachable, so nothing can throw after the swap
+        retired_.reserve(retired_.size() + 1);
+
+        block_.store(grown.get(), std::memory_order_seq_cst);
+        retired_.pushBack(RetiredBlock{block, epoch_.fetch_add(1, std::memory_order_seq_cst)});
+
+        block = grown.release();
+
+        reclaim();
+    }
+
+    block->values.pushBack(copy);
+    size_.store(size + 1, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+size_t RcuVector<T, Allocator>::reclaim()
+{
+    uint64_t oldest = oldestReaderEpoch();
+
+    // Readers pinned at an epoch later than the retirement loaded the buffer that replaced it
+    size_t kept = 0;
+    for (size_t pos = 0; pos < retired_.size(); ++pos)
+    {
+        if (retired_[pos].epoch < oldest)
+            delete retired_[pos].block;
+        else
+            retired_[kept++] = retired_[pos];
+    }
+
+    while (retired_.size() > kept)
+        retired_.popBack();
+
+    return kept;
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T, typename Allocator>
+uint64_t RcuVector<T, Allocator>::oldestReaderEpoch() const noexcept
+{
+    uint64_t oldest = epoch_.load(std::memory_order_seq_cst);
+
+    for (size_t readerId = 0; readerId < maxReaders_; ++readerId)
+    {
+        uint64_t epoch = readers_[readerId].epoch.load(std::memory_order_seq_cst);
+
+        if (epoch != inactive && epoch < oldest)
+            oldest = epoch;
+    }
+
+    return oldest;
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_RCU_VECTOR_HPP
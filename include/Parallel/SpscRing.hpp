@@ -0,0 +1,276 @@
+#ifndef PARALLEL_SPSC_RING_HPP
+#define PARALLEL_SPSC_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "VectorView.hpp"
+#include "CommonVectorFuncs.hpp"
+#include "Allocators/DynamicAllocator.hpp"
+#include "Allocators/StaticAllocator.hpp"
+#include "Parallel/CacheLine.hpp"
+
+namespace MyStd
+{
+
+namespace
+{
+
+// Inline capacity of a StaticAllocator, 0 for allocators that can hold any number of slots
+template<typename Allocator>
+struct RingInlineCapacity : std::integral_constant<size_t, 0> {};
+
+template<typename T, size_t capacity>
+struct RingInlineCapacity<StaticAllocator<T, capacity> > : std::integral_constant<size_t, capacity> {};
+
+} // namespace anon
+
+// Bounded lock free queue for exactly one producer thread and one consumer thread. Slots are capacity()
+// constructed elements owned by Allocator, e.g. StaticAllocator<T, N> keeps them inline. Capacity is
+// rounded up to a power of two, so N must be a power of two and the rounded capacity must fit into it.
+//
+// Producer only: tryPush, pushBatch, writableSpan, commitWrite
+// Consumer only: tryPop,  popBatch,  readableSpan, commitRead
+//
+// Head and tail sit on separate cache lines, each next to the side's cached copy of the other index,
+// so the sides touch each other's line only when the queue looks full or empty.
+template<typename T, typename Allocator = DynamicAllocator<T> >
+class SpscRing final
+{
+    static constexpr size_t inlineCapacity = RingInlineCapacity<Allocator>::value;
+
+    static_assert((inlineCapacity & (inlineCapacity - 1)) == 0, "inline ring storage must be a power of two");
+
+    struct alignas(cacheLineSize) ProducerSide
+    {
+        std::atomic<size_t> tail;
+        size_t cachedHead;
+
+        ProducerSide() noexcept : tail(0), cachedHead(0) {}
+    };
+
+    struct alignas(cacheLineSize) ConsumerSide
+    {
+        std::atomic<size_t> head;
+        size_t cachedTail;
+
+        ConsumerSide() noexcept : head(0), cachedTail(0) {}
+    };
+
+    Allocator storage_;
+    T* slots_;
+    size_t mask_;
+
+    ProducerSide producer_;
+    ConsumerSide consumer_;
+
+public:
+    // Throws when inline storage can't hold the rounded capacity
+    explicit SpscRing(size_t capacity);
+
+    SpscRing(const SpscRing& other) = delete;
+    SpscRing& operator=(const SpscRing& other) = delete;
+
+    ~SpscRing() = default;
+
+    bool tryPush(const T& value);
+
+    // Copies as many leading values as fit, returns their count. One index store for the whole batch
+    size_t pushBatch(VectorView<const T> values);
+
+    // Free slots to fill in place, contiguous, so it may be shorter than the free space at the wrap point.
+    // Nothing is visible to the consumer until commitWrite
+    VectorView<T> writableSpan();
+    void commitWrite(size_t count) noexcept;
+
+    bool tryPop(T& value);
+
+    // Moves up to out.size() elements to out, returns their count
+    size_t popBatch(VectorView<T> out);
+
+    // Filled slots to read in place, they stay valid until commitRead
+    VectorView<const T> readableSpan() noexcept;
+    void commitRead(size_t count) noexcept;
+
+    // Exact only from producer or consumer thread, a snapshot elsewhere
+    size_t size    () const noexcept;
+    bool   empty   () const noexcept;
+    size_t capacity() const noexcept;
+
+private:
+    // Free slots seen by the producer, reloads head only when there are less than wanted
+    size_t freeSlots(size_t tail, size_t wanted) noexcept;
+
+    // Filled slots seen by the consumer, reloads tail only when there are less than wanted
+    size_t filledSlots(size_t head, size_t wanted) noexcept;
+};
+
+// --------------------------Implementation-----------------------------------
+
+namespace
+{
+
+inline size_t ringCapacity(size_t capacity) noexcept
+{
+    if (capacity <= 1)
+        return 1;
+
+    return size_t(1) << (highestBit(capacity - 1) + 1);
+}
+
+} // namespace anon
+
+template<typename T, typename Allocator>
+SpscRing<T, Allocator>::SpscRing(size_t capacity) :
+    storage_(ringCapacity(capacity), T()), slots_(nullptr), mask_(ringCapacity(capacity) - 1),
+    producer_(), consumer_()
+{
+    slots_ = storage_.data();
+}
+
+template<typename T, typename Allocator>
+bool SpscRing<T, Allocator>::tryPush(const T& value)
+{
+    size_t tail = producer_.tail.load(std::memory_order_relaxed);
+
+    if (freeSlots(tail, 1) == 0)
+        return false;
+
+    slots_[tail & mask_] = value;
+    producer_.tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+template<typename T, typename Allocator>
+size_t SpscRing<T, Allocator>::pushBatch(VectorView<const T> values)
+{
+    size_t tail  = producer_.tail.load(std::memory_order_relaxed);
+    size_t count = std::min(values.size(), freeSlots(tail, values.size()));
+
+    size_t offset    = tail & mask_;
+    size_t firstPart = std::min(count, capacity() - offset);
+
+    std::copy(values.data(), values.data() + firstPart, slots_ + offset);
+    std::copy(values.data() + firstPart, values.data() + count, slots_);
+
+    producer_.tail.store(tail + count, std::memory_order_release);
+
+    return count;
+}
+
+template<typename T, typename Allocator>
+VectorView<T> SpscRing<T, Allocator>::writableSpan()
+{
+    size_t tail   = producer_.tail.load(std::memory_order_relaxed);
+    size_t offset = tail & mask_;
+
+    return VectorView<T>{slots_ + offset, std::min(freeSlots(tail, capacity()), capacity() - offset)};
+}
+
+template<typename T, typename Allocator>
+void SpscRing<T, Allocator>::commitWrite(size_t count) noexcept
+{
+    producer_.tail.store(producer_.tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+bool SpscRing<T, Allocator>::tryPop(T& value)
+{
+    size_t head = consumer_.head.load(std::memory_order_relaxed);
+
+    if (filledSlots(head, 1) == 0)
+        return false;
+
+    value = slots_[head & mask_];
+    consumer_.head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+template<typename T, typename Allocator>
+size_t SpscRing<T, Allocator>::popBatch(VectorView<T> out)
+{
+    size_t head  = consumer_.head.load(std::memory_order_relaxed);
+    size_t count = std::min(out.size(), filledSlots(head, out.size()));
+
+    size_t offset    = head & mask_;
+    size_t firstPart = std::min(count, capacity() - offset);
+
+    std::copy(slots_ + offset, slots_ + offset + firstPart, out.data());
+    std::copy(slots_, slots_ + (count - firstPart), out.data() + firstPart);
+
+    consumer_.head.store(head + count, std::memory_order_release);
+
+    return count;
+}
+
+template<typename T, typename Allocator>
+VectorView<const T> SpscRing<T, Allocator>::readableSpan() noexcept
+{
+    size_t head   = consumer_.head.load(std::memory_order_relaxed);
+    size_t offset = head & mask_;
+
+    return VectorView<const T>{slots_ + offset, std::min(filledSlots(head, capacity()), capacity() - offset)};
+}
+
+template<typename T, typename Allocator>
+void SpscRing<T, Allocator>::commitRead(size_t count) noexcept
+{
+    consumer_.head.store(consumer_.head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+size_t SpscRing<T, Allocator>::size() const noexcept
+{
+    size_t head = consumer_.head.load(std::memory_order_acquire);
+    size_t tail = producer_.tail.load(std::memory_order_acquire);
+
+    return tail - head;
+}
+
+template<typename T, typename Allocator>
+bool SpscRing<T, Allocator>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<typename T, typename Allocator>
+size_t SpscRing<T, Allocator>::capacity() const noexcept
+{
+    return mask_ + 1;
+}
+
+// ------------------------------Private------------------------------
+
+template<typename T, typename Allocator>
+size_t SpscRing<T, Allocator>::freeSlots(size_t tail, size_t wanted) noexcept
+{
+    size_t freeCount = capacity() - (tail - producer_.cachedHead);
+
+    if (freeCount >= wanted)
+        return freeCount;
+
+    producer_.cachedHead = consumer_.head.load(std::memory_order_acquire);
+
+    return capacity() - (tail - producer_.cachedHead);
+}
+
+template<typename T, typename Allocator>
+size_t SpscRing<T, Allocator>::filledSlots(size_t head, size_t wanted) noexcept
+{
+    size_t filledCount = consumer_.cachedTail - head;
+
+    if (filledCount >= wanted)
+        return filledCount;
+
+    consumer_.cachedTail = producer_.tail.load(std::memory_order_acquire);
+
+    return consumer_.cachedTail - head;
+}
+
+} // namespace MyStd
+
+#endif // PARALLEL_SPSC_RING_HPP
@@ -0,0 +1,76 @@
+#ifndef PARALLEL_THREAD_POOL_HPP
+#define PARALLEL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Parallel/CacheLine.hpp"
+
+namespace MyStd
+{
+
+class ThreadPool final
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threadsCount = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    ~ThreadPool();
+
+    size_t threadsCount() const noexcept;
+
+    // Pool without threads runs the task right in the caller
+    void submit(Task task);
+
+    // Calls body(chunkId) for every chunkId in [0, chunksCount) and waits for all of them.
+    // Caller thread takes part in the work, so nested calls from inside a task can't deadlock.
+    // First exception thrown by body is rethrown in the caller.
+    void parallelFor(size_t chunksCount, const std::function<void(size_t)>& body);
+
+    static ThreadPool& defaultPool();
+
+private:
+    struct alignas(cacheLineSize) WorkerQueue
+    {
+        std::mutex mutex_;
+        std::deque<Task> tasks_;
+
+        WorkerQueue() : mutex_(), tasks_() {}
+    };
+
+    std::vector<std::thread> threads_;
+    std::unique_ptr<WorkerQueue[]> queues_;
+    size_t queuesCount_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeUp_;
+
+    std::atomic<size_t> pendingTasks_;
+    std::atomic<size_t> nextQueue_;
+    bool stop_;
+
+    void workerLoop(size_t workerId);
+
+    bool tryPop  (size_t workerId, Task& task);
+    bool trySteal(size_t workerId, Task& task);
+
+    bool runPendingTask(size_t workerId);
+
+    void stopWorkers() noexcept;
+};
+
+} // namespace MyStd
+
+#endif // PARALLEL_THREAD_POOL_HPP
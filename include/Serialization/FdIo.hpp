@@ -0,0 +1,103 @@
+#ifndef SERIALIZATION_FD_IO_HPP
+#define SERIALIZATION_FD_IO_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "CommonVectorFuncs.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Raw element bytes between vectors and blocking file descriptors, read and written in place without
+// intermediate buffers. Trivially copyable elements only, not Vector<bool>. EINTR is retried, other failures
+// throw FdIoErr
+
+// Whole elements received by one read. error is FdIoErr when the stream ended or failed inside the element
+// after them: bytes taken from the stream can't be read again, so the complete elements are still kept
+// and only the incomplete one is dropped
+struct FdReadResult
+{
+    size_t count;
+    StdErrors error;
+};
+
+// Appends at most maxBytes worth of whole elements, count is 0 at the end of stream.
+// Bytes go straight into spare capacity and only complete elements are committed: a read stopping inside
+// an element keeps reading until it is complete
+template<typename T, typename Allocator>
+FdReadResult appendFromFd(Vector<T, Allocator>& vector, int fd, size_t maxBytes);
+
+// Fills the whole view, a stream ending earlier is an error
+template<typename T>
+void readExactly(int fd, VectorView<T> view);
+
+template<typename T>
+void writeToFd(int fd, VectorView<const T> view);
+
+template<typename T, typename Allocator>
+void writeToFd(int fd, const Vector<T, Allocator>& vector);
+
+// Byte level versions. readBytes counts whole pieces of granularity bytes, 0 only at the end of stream.
+// It throws only when nothing was taken from the stream yet
+FdReadResult readBytes(int fd, void* data, size_t maxBytes, size_t granularity);
+void readBytesExactly(int fd, void* data, size_t bytes);
+void writeBytes(int fd, const void* data, size_t bytes);
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator>
+FdReadResult appendFromFd(Vector<T, Allocator>& vector, int fd, size_t maxBytes)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be read as bytes");
+    static_assert(!std::is_same<std::remove_const_t<T>, bool>::value, "Vector<bool> stores packed bits, not bytes");
+
+    size_t maxCount = maxBytes / sizeof(T);
+    if (maxCount == 0)
+        return FdReadResult{0, StdErrors::Ok};
+
+    size_t oldSize = vector.size();
+    if (oldSize + maxCount > vector.capacity())
+        vector.reserve(std::max(oldSize + maxCount, getCapacityAfterGrowth(vector.capacity())));
+
+    // Spare capacity is filled first, the size grows only by what was received
+    FdReadResult got = readBytes(fd, vector.data() + oldSize, maxCount * sizeof(T), sizeof(T));
+    vector.resizeUninitialized(oldSize + got.count);
+
+    return got;
+}
+
+template<typename T>
+void readExactly(int fd, VectorView<T> view)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be read as bytes");
+    static_assert(!std::is_same<std::remove_const_t<T>, bool>::value, "Vector<bool> stores packed bits, not bytes");
+    static_assert(!std::is_const<T>::value, "can't read into a read only view");
+
+    readBytesExactly(fd, view.data(), view.size() * sizeof(T));
+}
+
+template<typename T>
+void writeToFd(int fd, VectorView<const T> view)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be written as bytes");
+    static_assert(!std::is_same<std::remove_const_t<T>, bool>::value, "Vector<bool> stores packed bits, not bytes");
+
+    writeBytes(fd, view.data(), view.size() * sizeof(T));
+}
+
+template<typename T, typename Allocator>
+void writeToFd(int fd, const Vector<T, Allocator>& vector)
+{
+    writeToFd(fd, VectorView<const T>{vector});
+}
+
+} // namespace MyStd
+
+#endif // SERIALIZATION_FD_IO_HPP
@@ -0,0 +1,193 @@
+#ifndef SERIALIZATION_SNAPSHOT_HPP
+#define SERIALIZATION_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "Vector.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Binary snapshot of a vector: fixed header followed by raw element bytes.
+// A stream may hold several snapshots one after another, they are read back in the same order.
+
+enum class SnapshotKind : uint16_t
+{
+    Elements = 1, // Vector<T>, elementSize bytes per element
+    Bits     = 2, // Vector<bool>, count bits packed into bytes
+};
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t kind;
+    uint32_t endianness;  // snapshotEndiannessMark in the writer's byte order
+    uint32_t elementSize;
+    uint64_t count;
+    uint64_t checksum;    // of the payload only
+};
+
+static_assert(sizeof(SnapshotHeader) == 32, "snapshot header layout is part of the format");
+
+constexpr uint32_t snapshotMagic          = 0x53565331; // "SVS1"
+constexpr uint16_t snapshotVersion        = 1;
+constexpr uint32_t snapshotEndiannessMark = 0x01020304;
+
+// Streaming checksum over 8-byte words, independent of how the payload is split into updates
+class SnapshotChecksum final
+{
+    uint64_t state_;
+    uint64_t tail_;
+    size_t tailSize_;
+
+public:
+    SnapshotChecksum() noexcept;
+
+    void update(const void* data, size_t bytes) noexcept;
+    uint64_t value() const noexcept;
+};
+
+class SnapshotWriter final
+{
+    int fd_;
+    bool ownsFd_;
+
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t buffered_;
+
+public:
+    // Small snapshots are gathered up to this size, bigger payloads go to writev without copying
+    static constexpr size_t chunkSize = 1 << 20;
+
+    explicit SnapshotWriter(const char* path);
+    explicit SnapshotWriter(int fd); // fd is not closed by the writer
+
+    SnapshotWriter(const SnapshotWriter& other) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter& other) = delete;
+
+    // Flushes what is left, a failure is reported to stderr because destructor never throws
+    ~SnapshotWriter();
+
+    template<typename T, typename Allocator>
+    void write(const Vector<T, Allocator>& vector);
+
+    template<typename Allocator>
+    void write(const Vector<bool, Allocator>& vector);
+
+    void flush();
+
+private:
+    void writeSnapshot(SnapshotKind kind, uint32_t elementSize, uint64_t count, const void* payload, size_t bytes);
+};
+
+class SnapshotReader final
+{
+    int fd_;
+    bool ownsFd_;
+
+public:
+    explicit SnapshotReader(const char* path);
+    explicit SnapshotReader(int fd); // fd is not closed by the reader
+
+    SnapshotReader(const SnapshotReader& other) = delete;
+    SnapshotReader& operator=(const SnapshotReader& other) = delete;
+
+    ~SnapshotReader();
+
+    // Payload is read straight into reserved capacity, vector is replaced only if the checksum matches
+    template<typename T, typename Allocator>
+    void read(Vector<T, Allocator>& vector);
+
+    template<typename Allocator>
+    void read(Vector<bool, Allocator>& vector);
+
+private:
+    // Rejects counts that need more bytes than a regular file has left
+    SnapshotHeader readHeader(SnapshotKind kind, uint32_t elementSize);
+    static uint64_t payloadBytes(SnapshotKind kind, uint64_t count, uint32_t elementSize) noexcept;
+    void readPayload(void* data, size_t bytes, uint64_t checksum);
+};
+
+template<typename T, typename Allocator>
+void saveSnapshot(const char* path, const Vector<T, Allocator>& vector);
+
+template<typename T, typename Allocator>
+void loadSnapshot(const char* path, Vector<T, Allocator>& vector);
+
+// --------------------------Implementation-----------------------------------
+
+template<typename T, typename Allocator>
+void SnapshotWriter::write(const Vector<T, Allocator>& vector)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be snapshotted");
+
+    writeSnapshot(SnapshotKind::Elements, sizeof(T), vector.size(), vector.data(), vector.size() * sizeof(T));
+}
+
+template<typename Allocator>
+void SnapshotWriter::write(const Vector<bool, Allocator>& vector)
+{
+    size_t bytes = (vector.size() + __CHAR_BIT__ - 1) / __CHAR_BIT__;
+
+    writeSnapshot(SnapshotKind::Bits, 1, vector.size(), vector.data(), bytes);
+}
+
+template<typename T, typename Allocator>
+void SnapshotReader::read(Vector<T, Allocator>& vector)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be snapshotted");
+
+    SnapshotHeader header = readHeader(SnapshotKind::Elements, sizeof(T));
+    size_t count = static_cast<size_t>(header.count);
+
+    Vector<T, Allocator> loaded;
+    loaded.reserve(count);
+
+    readPayload(loaded.data(), count * sizeof(T), header.checksum);
+    loaded.resizeUninitialized(count);
+
+    vector.swap(loaded);
+}
+
+template<typename Allocator>
+void SnapshotReader::read(Vector<bool, Allocator>& vector)
+{
+    SnapshotHeader header = readHeader(SnapshotKind::Bits, 1);
+    size_t count = static_cast<size_t>(header.count);
+
+    Vector<bool, Allocator> loaded;
+    loaded.reserve(count);
+
+    readPayload(loaded.data(), (count + __CHAR_BIT__ - 1) / __CHAR_BIT__, header.checksum);
+    loaded.resizeUninitialized(count);
+
+    vector.swap(loaded);
+}
+
+template<typename T, typename Allocator>
+void saveSnapshot(const char* path, const Vector<T, Allocator>& vector)
+{
+    SnapshotWriter writer{path};
+
+    writer.write(vector);
+    writer.flush();
+}
+
+template<typename T, typename Allocator>
+void loadSnapshot(const char* path, Vector<T, Allocator>& vector)
+{
+    SnapshotReader reader{path};
+
+    reader.read(vector);
+}
+
+} // namespace MyStd
+
+#endif // SERIALIZATION_SNAPSHOT_HPP
@@ -0,0 +1,326 @@
+#ifndef SIMD_SIMD_KERNELS_HPP
+#define SIMD_SIMD_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+enum class SimdLevel
+{
+    Scalar = 0,
+    Sse2,
+    Avx2,
+    Avx512,
+};
+
+// Best level supported by this cpu, found once from cpuid
+SimdLevel detectedSimdLevel() noexcept;
+
+SimdLevel activeSimdLevel() noexcept;
+
+// Level is clamped to detectedSimdLevel(), lets tests run every code path
+void setSimdLevel(SimdLevel level) noexcept;
+
+namespace Simd
+{
+
+template<typename T>
+struct IsSupportedType : std::integral_constant<bool,
+    std::is_same<T, float>::value   || std::is_same<T, double>::value ||
+    std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value
+> {};
+
+// Raw kernels, defined in SimdKernels.cpp for float, double, int32_t and int64_t.
+// argMin/argMax return the first position of the extremum, find returns size if value is absent.
+
+template<typename T> T      sum   (const T* data, size_t size) noexcept;
+template<typename T> T      dot   (const T* lhs, const T* rhs, size_t size) noexcept;
+template<typename T> size_t argMin(const T* data, size_t size) noexcept;
+template<typename T> size_t argMax(const T* data, size_t size) noexcept;
+template<typename T> size_t find  (const T* data, size_t size, T value) noexcept;
+template<typename T> size_t count (const T* data, size_t size, T value) noexcept;
+
+// data[i] *= factor
+template<typename T> void scale(T* data, size_t size, T factor) noexcept;
+// dst[i] += src[i]
+template<typename T> void add  (T* dst, const T* src, size_t size) noexcept;
+// dst[i] += lhs[i] * rhs[i]
+template<typename T> void fma  (T* dst, const T* lhs, const T* rhs, size_t size) noexcept;
+
+// out[i] = value first + i of count bits wide (1..32) unsigned values packed back to back into
+// wordsCount words, lowest bits first. Used by PackedIntVector
+void unpackBits(
+    const uint64_t* words, size_t wordsCount, unsigned bits, size_t first, size_t count, uint32_t* out
+) noexcept;
+
+// View overloads, mutating kernels need a view of non-const elements
+
+template<typename T>
+std::remove_const_t<T> sum(VectorView<T> view) noexcept;
+
+template<typename Lhs, typename Rhs>
+std::remove_const_t<Lhs> dot(VectorView<Lhs> lhs, VectorView<Rhs> rhs);
+
+// min/max/argMin/argMax require non empty view
+template<typename T>
+std::remove_const_t<T> min(VectorView<T> view) noexcept;
+
+template<typename T>
+std::remove_const_t<T> max(VectorView<T> view) noexcept;
+
+template<typename T>
+size_t argMin(VectorView<T> view) noexcept;
+
+template<typename T>
+size_t argMax(VectorView<T> view) noexcept;
+
+template<typename T>
+size_t find(VectorView<T> view, std::remove_const_t<T> value) noexcept;
+
+template<typename T>
+size_t count(VectorView<T> view, std::remove_const_t<T> value) noexcept;
+
+template<typename T>
+void scale(VectorView<T> view, T factor) noexcept;
+
+template<typename T, typename Src>
+void add(VectorView<T> dst, VectorView<Src> src);
+
+template<typename T, typename Lhs, typename Rhs>
+void fma(VectorView<T> dst, VectorView<Lhs> lhs, VectorView<Rhs> rhs);
+
+// Vector overloads
+
+template<typename T, typename Allocator>
+T sum(const Vector<T, Allocator>& vector) noexcept;
+
+template<typename T, typename LhsAllocator, typename RhsAllocator>
+T dot(const Vector<T, LhsAllocator>& lhs, const Vector<T, RhsAllocator>& rhs);
+
+// min/max/argMin/argMax require non empty vector
+template<typename T, typename Allocator>
+T min(const Vector<T, Allocator>& vector) noexcept;
+
+template<typename T, typename Allocator>
+T max(const Vector<T, Allocator>& vector) noexcept;
+
+template<typename T, typename Allocator>
+size_t argMin(const Vector<T, Allocator>& vector) noexcept;
+
+template<typename T, typename Allocator>
+size_t argMax(const Vector<T, Allocator>& vector) noexcept;
+
+template<typename T, typename Allocator>
+size_t find(const Vector<T, Allocator>& vector, T value) noexcept;
+
+template<typename T, typename Allocator>
+size_t count(const Vector<T, Allocator>& vector, T value) noexcept;
+
+template<typename T, typename Allocator>
+void scale(Vector<T, Allocator>& vector, T factor) noexcept;
+
+template<typename T, typename DstAllocator, typename SrcAllocator>
+void add(Vector<T, DstAllocator>& dst, const Vector<T, SrcAllocator>& src);
+
+template<typename T, typename DstAllocator, typename LhsAllocator, typename RhsAllocator>
+void fma(Vector<T, DstAllocator>& dst, const Vector<T, LhsAllocator>& lhs, const Vector<T, RhsAllocator>& rhs);
+
+// --------------------------Implementation-----------------------------------
+
+namespace
+{
+
+inline void checkSameSize(size_t lhsSize, size_t rhsSize)
+{
+    if (lhsSize != rhsSize)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorSizeMismatch,
+            "Vectors passed to simd kernel have different sizes",
+            {}
+        );
+    }
+}
+
+template<typename T>
+struct IsSupportedView : IsSupportedType<std::remove_const_t<T> > {};
+
+template<typename Lhs, typename Rhs>
+struct IsSameElement : std::is_same<std::remove_const_t<Lhs>, std::remove_const_t<Rhs> > {};
+
+} // namespace anon
+
+template<typename T>
+std::remove_const_t<T> sum(VectorView<T> view) noexcept
+{
+    static_assert(IsSupportedView<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+
+    return sum(view.data(), view.size());
+}
+
+template<typename Lhs, typename Rhs>
+std::remove_const_t<Lhs> dot(VectorView<Lhs> lhs, VectorView<Rhs> rhs)
+{
+    static_assert(IsSupportedView<Lhs>::value, "simd kernels support only float, double, int32_t and int64_t");
+    static_assert(IsSameElement<Lhs, Rhs>::value, "views passed to simd kernel must have the same element type");
+
+    checkSameSize(lhs.size(), rhs.size());
+
+    return dot<std::remove_const_t<Lhs> >(lhs.data(), rhs.data(), lhs.size());
+}
+
+template<typename T>
+std::remove_const_t<T> min(VectorView<T> view) noexcept
+{
+    return view[argMin(view)];
+}
+
+template<typename T>
+std::remove_const_t<T> max(VectorView<T> view) noexcept
+{
+    return view[argMax(view)];
+}
+
+template<typename T>
+size_t argMin(VectorView<T> view) noexcept
+{
+    static_assert(IsSupportedView<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+
+    return argMin(view.data(), view.size());
+}
+
+template<typename T>
+size_t argMax(VectorView<T> view) noexcept
+{
+    static_assert(IsSupportedView<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+
+    return argMax(view.data(), view.size());
+}
+
+template<typename T>
+size_t find(VectorView<T> view, std::remove_const_t<T> value) noexcept
+{
+    static_assert(IsSupportedView<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+
+    return find<std::remove_const_t<T> >(view.data(), view.size(), value);
+}
+
+template<typename T>
+size_t count(VectorView<T> view, std::remove_const_t<T> value) noexcept
+{
+    static_assert(IsSupportedView<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+
+    return count<std::remove_const_t<T> >(view.data(), view.size(), value);
+}
+
+template<typename T>
+void scale(VectorView<T> view, T factor) noexcept
+{
+    static_assert(IsSupportedType<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+
+    scale(view.data(), view.size(), factor);
+}
+
+template<typename T, typename Src>
+void add(VectorView<T> dst, VectorView<Src> src)
+{
+    static_assert(IsSupportedType<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+    static_assert(IsSameElement<T, Src>::value, "views passed to simd kernel must have the same element type");
+
+    checkSameSize(dst.size(), src.size());
+
+    add<T>(dst.data(), src.data(), dst.size());
+}
+
+template<typename T, typename Lhs, typename Rhs>
+void fma(VectorView<T> dst, VectorView<Lhs> lhs, VectorView<Rhs> rhs)
+{
+    static_assert(IsSupportedType<T>::value, "simd kernels support only float, double, int32_t and int64_t");
+    static_assert(IsSameElement<T, Lhs>::value && IsSameElement<T, Rhs>::value,
+                  "views passed to simd kernel must have the same element type");
+
+    checkSameSize(dst.size(), lhs.size());
+    checkSameSize(dst.size(), rhs.size());
+
+    fma<T>(dst.data(), lhs.data(), rhs.data(), dst.size());
+}
+
+template<typename T, typename Allocator>
+T sum(const Vector<T, Allocator>& vector) noexcept
+{
+    return sum(VectorView<const T>{vector});
+}
+
+template<typename T, typename LhsAllocator, typename RhsAllocator>
+T dot(const Vector<T, LhsAllocator>& lhs, const Vector<T, RhsAllocator>& rhs)
+{
+    return dot(VectorView<const T>{lhs}, VectorView<const T>{rhs});
+}
+
+template<typename T, typename Allocator>
+T min(const Vector<T, Allocator>& vector) noexcept
+{
+    return min(VectorView<const T>{vector});
+}
+
+template<typename T, typename Allocator>
+T max(const Vector<T, Allocator>& vector) noexcept
+{
+    return max(VectorView<const T>{vector});
+}
+
+template<typename T, typename Allocator>
+size_t argMin(const Vector<T, Allocator>& vector) noexcept
+{
+    return argMin(VectorView<const T>{vector});
+}
+
+template<typename T, typename Allocator>
+size_t argMax(const Vector<T, Allocator>& vector) noexcept
+{
+    return argMax(VectorView<const T>{vector});
+}
+
+template<typename T, typename Allocator>
+size_t find(const Vector<T, Allocator>& vector, T value) noexcept
+{
+    return find(VectorView<const T>{vector}, value);
+}
+
+template<typename T, typename Allocator>
+size_t count(const Vector<T, Allocator>& vector, T value) noexcept
+{
+    return count(VectorView<const T>{vector}, value);
+}
+
+template<typename T, typename Allocator>
+void scale(Vector<T, Allocator>& vector, T factor) noexcept
+{
+    scale(VectorView<T>{vector}, factor);
+}
+
+template<typename T, typename DstAllocator, typename SrcAllocator>
+void add(Vector<T, DstAllocator>& dst, const Vector<T, SrcAllocator>& src)
+{
+    add(VectorView<T>{dst}, VectorView<const T>{src});
+}
+
+template<typename T, typename DstAllocator, typename LhsAllocator, typename RhsAllocator>
+void fma(Vector<T, DstAllocator>& dst, const Vector<T, LhsAllocator>& lhs, const Vector<T, RhsAllocator>& rhs)
+{
+    fma(VectorView<T>{dst}, VectorView<const T>{lhs}, VectorView<const T>{rhs});
+}
+
+} // namespace Simd
+
+} // namespace MyStd
+
+#endif // SIMD_SIMD_KERNELS_HPP
@@ -4,11 +4,19 @@
 #include <stddef.h>
 
 #include "VectorIteratorClass.hpp"
+#include "Expected.hpp"
 #include "Allocators/DynamicAllocator.hpp"
 
 namespace MyStd
 {
 
+// Bytes of element storage held by a vector: taken by elements and reserved but unused
+struct VectorMemoryUsage
+{
+    size_t liveBytes;
+    size_t slackBytes;
+};
+
 template <typename T, typename Allocator = DynamicAllocator<T> >
 class Vector final
 {
@@ -23,6 +31,9 @@ public:
     Vector(const ConstIterator& first, const ConstIterator& last);
     Vector(const Vector& other) = default;
 
+    // Adopts allocator's elements as they are, e.g. an allocator reopened over existing storage
+    explicit Vector(Allocator&& allocator);
+
     Vector(Vector&& other) = default;
 
     Vector& operator=(const Vector& other);
@@ -60,8 +71,12 @@ public:
     size_t size    () const noexcept;
     size_t capacity() const noexcept;
 
+    VectorMemoryUsage memoryUsage() const noexcept;
+
     void reserve(size_t newCapacity);
 
+    // Does nothing when there is no slack. Popping elements never frees memory by itself,
+    // ShrinkingAllocator adds that as an opt-in policy
     void shrinkToFit();
     void clear() noexcept;
 
@@ -79,8 +94,20 @@ public:
 
     void resize(size_t newSize, const T& value = T());
 
+    // Trivially copyable T only: elements appended this way are left uninitialized, caller fills them through data()
+    void resizeUninitialized(size_t newSize);
+
     void swap(Vector& other);
 
+    // Non-throwing variants report failures instead of building exceptions. They need nothrow copyable
+    // elements and an allocator with tryRealloc
+    StdErrors tryReserve(size_t newCapacity) noexcept;
+    StdErrors tryPushBack(const T& value) noexcept;
+    StdErrors tryResize(size_t newSize, const T& value = T()) noexcept;
+
+    Expected<T&>       tryAt(size_t pos) noexcept;
+    Expected<const T&> tryAt(size_t pos) const noexcept;
+
 private:
     enum class PushResult
     {
@@ -89,6 +116,9 @@ private:
     };
 
     PushResult tryPush(const T& value);
+
+    // Position of value if it is one of our elements, size() otherwise. Survives reallocation, the reference doesn't
+    size_t positionOf(const T& value) const noexcept;
 };
 
 #if 0
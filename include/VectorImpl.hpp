@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <functional>
+#include <type_traits>
 
 namespace MyStd
 {
@@ -17,15 +19,15 @@ namespace
 {
 
 #define CATCH_EXCEPTION(ERROR, REASON)  \
-    catch (ExceptionWithReason& exception) \
+    EXCEPTIONS_CATCH_WITH_REASON(exception) \
     { \
         allocator.dtorElements(from, dataPos - 1); \
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(ERROR, REASON, std::move(exception)); \
+        THROW_EXCEPTION_WITH_REASON(ERROR, REASON, std::move(exception)); \
     } \
-    catch (...) \
+    EXCEPTIONS_CATCH(...) \
     { \
         allocator.dtorElements(from, dataPos - 1); \
-        throw; \
+        EXCEPTIONS_RETHROW; \
     }
 
 
@@ -33,7 +35,7 @@ template<typename Allocator, typename ConstIterator>
 void copyToEmptyData(Allocator& allocator, const size_t from, ConstIterator first, ConstIterator last)
 {
     size_t dataPos = from;
-    try
+    EXCEPTIONS_TRY
     {
         for (ConstIterator it = first; it != last; ++it)
         {
@@ -48,7 +50,7 @@ template<typename T, typename Allocator>
 void copyToEmptyData(Allocator& allocator, const size_t from, size_t count, const T& value)
 {
     size_t dataPos = from;
-    try
+    EXCEPTIONS_TRY
     {
         for (dataPos = from; dataPos < count + from; ++dataPos)
         {
@@ -61,14 +63,14 @@ void copyToEmptyData(Allocator& allocator, const size_t from, size_t count, cons
 template<typename T, typename Allocator>
 void tryCopyToEmptyDataElseDelete(Allocator& allocator, size_t from, size_t count, const T& value)
 {
-    try
+    EXCEPTIONS_TRY
     {
         copyToEmptyData(allocator, from, count, value);
     }
-    catch (...)
+    EXCEPTIONS_CATCH(...)
     {
         allocator.free();
-        throw;
+        EXCEPTIONS_RETHROW;
     }
 }
 
@@ -77,14 +79,14 @@ void tryCopyToEmptyDataElseDelete(
     Allocator& allocator, const size_t from, ConstIterator first, ConstIterator last
 )
 {
-    try
+    EXCEPTIONS_TRY
     {
         copyToEmptyData(allocator, from, first, last);
     }
-    catch(...)
+    EXCEPTIONS_CATCH(...)
     {
         allocator.free();
-        throw;
+        EXCEPTIONS_RETHROW;
     }
 }
 
@@ -93,7 +95,7 @@ void rewriteData(Allocator& allocator, size_t from, size_t count, const T& value
 {
     size_t dataPos = from;
 
-    try
+    EXCEPTIONS_TRY
     {
         for (dataPos = from; dataPos < count + from; ++dataPos)
         {
@@ -108,7 +110,7 @@ void rewriteData(Allocator& allocator, size_t from, ConstIterator first, ConstIt
 {
     size_t dataPos = from;
 
-    try
+    EXCEPTIONS_TRY
     {
         for (ConstIterator it = first; it != last; ++it)
         {
@@ -134,6 +136,11 @@ Vector<T, Allocator>::Vector(const ConstIterator& first, const ConstIterator& la
     tryCopyToEmptyDataElseDelete(allocator_, 0, first, last);
 }
 
+template<typename T, typename Allocator>
+Vector<T, Allocator>::Vector(Allocator&& allocator) : allocator_(std::move(allocator))
+{
+}
+
 template<typename T, typename Allocator>
 Vector<T, Allocator>& Vector<T, Allocator>::operator=(const Vector& other)
 {
@@ -147,7 +154,7 @@ typename Vector<T, Allocator>::Iterator::Reference Vector<T, Allocator>::at(size
 {
     if (pos >= allocator_.size())
     {
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorIndexOutOfBounds,
             "Vector index out of bounds",
             {}
@@ -162,7 +169,7 @@ typename Vector<T, Allocator>::ConstIterator::ConstReference Vector<T, Allocator
 {
     if (pos >= allocator_.size())
     {
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorIndexOutOfBounds,
             "Vector index out of bounds",
             {}
@@ -263,6 +270,12 @@ size_t Vector<T, Allocator>::capacity() const noexcept
     return allocator_.capacity();
 }
 
+template<typename T, typename Allocator>
+VectorMemoryUsage Vector<T, Allocator>::memoryUsage() const noexcept
+{
+    return {allocator_.size() * sizeof(T), (allocator_.capacity() - allocator_.size()) * sizeof(T)};
+}
+
 template<typename T, typename Allocator>
 void Vector<T, Allocator>::reserve(size_t newCapacity)
 {
@@ -273,6 +286,9 @@ void Vector<T, Allocator>::reserve(size_t newCapacity)
 template<typename T, typename Allocator>
 void Vector<T, Allocator>::shrinkToFit()
 {
+    if (allocator_.size() == allocator_.capacity())
+        return;
+
     allocator_.realloc(allocator_.size());
 }
 
@@ -292,16 +308,14 @@ void Vector<T, Allocator>::pushBack(const T& value)
 
     assert(pushResult == PushResult::NeedToResize);
 
-    Vector<T, Allocator> newVector;
+    // Growth goes through the allocator itself, so stateful allocators keep their backing storage
+    size_t oldSize  = allocator_.size();
+    size_t valuePos = positionOf(value);
 
-    newVector.reserve(getCapacityAfterGrowth(allocator_.capacity()));
-    
-    copyToEmptyData(newVector.allocator_, 0, begin(), end());
+    reserve(getCapacityAfterGrowth(allocator_.capacity(), AllocatorMaxCapacity<Allocator>::value));
 
-    pushResult = newVector.tryPush(value);
+    pushResult = tryPush(valuePos < oldSize ? allocator_.data()[valuePos] : value);
     assert(pushResult == PushResult::Ok);
-
-    swap(newVector);
 }
 
 template<typename T, typename Allocator>
@@ -315,12 +329,28 @@ void Vector<T, Allocator>::popBack() noexcept
 template<typename T, typename Allocator>
 void Vector<T, Allocator>::resize(size_t newSize, const T& value)
 {
-    Allocator newAllocator{newSize, value};
+    size_t oldSize = allocator_.size();
 
-    ConstIterator endCopyData = begin() + std::min(allocator_.size(), newSize);
-    copyToEmptyData(newAllocator, 0, begin(), endCopyData);
+    if (newSize <= oldSize)
+    {
+        allocator_.dtorElements(newSize, oldSize);
+        return;
+    }
 
-    allocator_.swap(newAllocator);
+    // value may be one of our own elements
+    T fillValue{value};
+
+    reserve(newSize);
+    copyData(allocator_, oldSize, newSize - oldSize, fillValue);
+}
+
+template<typename T, typename Allocator>
+void Vector<T, Allocator>::resizeUninitialized(size_t newSize)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "uninitialized elements are allowed only for trivial types");
+
+    reserve(newSize);
+    allocator_.size(newSize);
 }
 
 template<typename T, typename Allocator>
@@ -329,6 +359,88 @@ void Vector<T, Allocator>::swap(Vector& other)
     allocator_.swap(other.allocator_);
 }
 
+template<typename T, typename Allocator>
+StdErrors Vector<T, Allocator>::tryReserve(size_t newCapacity) noexcept
+{
+    if (newCapacity <= allocator_.capacity())
+        return StdErrors::Ok;
+
+    return allocator_.tryRealloc(newCapacity);
+}
+
+template<typename T, typename Allocator>
+StdErrors Vector<T, Allocator>::tryPushBack(const T& value) noexcept
+{
+    static_assert(std::is_nothrow_copy_constructible<T>::value, "tryPushBack can't copy elements that may throw");
+
+    size_t size     = allocator_.size();
+    size_t valuePos = size;
+
+    if (size == allocator_.capacity())
+    {
+        valuePos = positionOf(value);
+
+        size_t newCapacity = getCapacityAfterGrowth(allocator_.capacity(), AllocatorMaxCapacity<Allocator>::value);
+
+        StdErrors error = tryReserve(newCapacity);
+        if (error != StdErrors::Ok)
+            return error;
+    }
+
+    constructInMemory(allocator_.data() + size, valuePos < size ? allocator_.data()[valuePos] : value);
+    allocator_.size(size + 1);
+
+    return StdErrors::Ok;
+}
+
+template<typename T, typename Allocator>
+StdErrors Vector<T, Allocator>::tryResize(size_t newSize, const T& value) noexcept
+{
+    static_assert(std::is_nothrow_copy_constructible<T>::value, "tryResize can't copy elements that may throw");
+
+    size_t oldSize = allocator_.size();
+
+    if (newSize <= oldSize)
+    {
+        allocator_.dtorElements(newSize, oldSize);
+        return StdErrors::Ok;
+    }
+
+    size_t valuePos = positionOf(value);
+
+    StdErrors error = tryReserve(newSize);
+    if (error != StdErrors::Ok)
+        return error;
+
+    T* data = allocator_.data();
+    const T& fillValue = valuePos < oldSize ? data[valuePos] : value;
+
+    for (size_t pos = oldSize; pos < newSize; ++pos)
+        constructInMemory(data + pos, fillValue);
+
+    allocator_.size(newSize);
+
+    return StdErrors::Ok;
+}
+
+template<typename T, typename Allocator>
+Expected<T&> Vector<T, Allocator>::tryAt(size_t pos) noexcept
+{
+    if (pos >= allocator_.size())
+        return StdErrors::VectorIndexOutOfBounds;
+
+    return Expected<T&>{allocator_.data()[pos]};
+}
+
+template<typename T, typename Allocator>
+Expected<const T&> Vector<T, Allocator>::tryAt(size_t pos) const noexcept
+{
+    if (pos >= allocator_.size())
+        return StdErrors::VectorIndexOutOfBounds;
+
+    return Expected<const T&>{allocator_.data()[pos]};
+}
+
 // ------------------------------Private------------------------------
 
 template<typename T, typename Allocator>
@@ -337,13 +449,13 @@ typename Vector<T, Allocator>::PushResult Vector<T, Allocator>::tryPush(const T&
     if (allocator_.size() >= allocator_.capacity())
         return PushResult::NeedToResize;
 
-    try
+    EXCEPTIONS_TRY
     {
         allocator_[allocator_.size()] = value;
     }
-    catch (ExceptionWithReason& exception)
+    EXCEPTIONS_CATCH_WITH_REASON(exception)
     {
-        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+        THROW_EXCEPTION_WITH_REASON(
             StdErrors::VectorCtorErr,
             "Failed to copy elements while pushing to vector",
             std::move(exception)
@@ -353,6 +465,17 @@ typename Vector<T, Allocator>::PushResult Vector<T, Allocator>::tryPush(const T&
     return PushResult::Ok;
 }
 
+template<typename T, typename Allocator>
+size_t Vector<T, Allocator>::positionOf(const T& value) const noexcept
+{
+    const T* data = allocator_.data();
+
+    if (std::less<const T*>{}(&value, data) || !std::less<const T*>{}(&value, data + allocator_.size()))
+        return allocator_.size();
+
+    return static_cast<size_t>(&value - data);
+}
+
 } // namespace MyStd
 
 #endif // VECTOR_IMPL_HPP
\ No newline at end of file
@@ -0,0 +1,337 @@
+#ifndef VECTOR_VIEW_HPP
+#define VECTOR_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Vector.hpp"
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+// Non-owning window over contiguous elements, VectorView<const T> for read only access.
+// Valid while the viewed vector is not reallocated.
+template<typename T>
+class VectorView final
+{
+    using ValueType = typename std::remove_const<T>::type;
+
+    static_assert(!std::is_same<ValueType, bool>::value, "use BitView for Vector<bool>");
+
+    T* data_;
+    size_t size_;
+
+public:
+    using Iterator = VectorIterator<T>;
+
+    static constexpr size_t toEnd = static_cast<size_t>(-1);
+
+    VectorView() noexcept : data_(nullptr), size_(0) {}
+    VectorView(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    template<typename Allocator>
+    VectorView(Vector<ValueType, Allocator>& vector) noexcept;
+
+    template<typename Allocator, typename U = T, typename = std::enable_if_t<std::is_const<U>::value> >
+    VectorView(const Vector<ValueType, Allocator>& vector) noexcept;
+
+    // VectorView<T> -> VectorView<const T>
+    template<typename U, typename = std::enable_if_t<std::is_same<const U, T>::value && !std::is_const<U>::value> >
+    VectorView(const VectorView<U>& other) noexcept;
+
+    T& at(size_t pos) const;
+    T& operator[](size_t pos) const noexcept;
+
+    T& front() const noexcept;
+    T& back () const noexcept;
+
+    T* data() const noexcept;
+
+    Iterator begin() const noexcept;
+    Iterator end  () const noexcept;
+
+    bool   empty() const noexcept;
+    size_t size () const noexcept;
+
+    // Elements [offset, offset + count), count is clamped to the end of the view
+    VectorView subview(size_t offset, size_t count = toEnd) const;
+};
+
+// Same for bits: BitView over Vector<bool> may start at any bit, not only on a byte boundary.
+template<typename Byte>
+class BasicBitView final
+{
+    static_assert(std::is_same<typename std::remove_const<Byte>::type, uint8_t>::value, "bits are stored in bytes");
+
+    Byte* data_;
+    size_t offset_; // position of the first bit in data_, always less than a byte
+    size_t size_;
+
+public:
+    class Iterator final
+    {
+        const uint8_t* data_;
+        size_t pos_;
+
+    public:
+        Iterator(const uint8_t* data, size_t pos) noexcept : data_(data), pos_(pos) {}
+
+        Iterator& operator++() noexcept { ++pos_; return *this; }
+
+        bool operator*() const noexcept { return getBit(data_, pos_); }
+
+        bool operator==(const Iterator& other) const noexcept { return pos_ == other.pos_; }
+        bool operator!=(const Iterator& other) const noexcept { return pos_ != other.pos_; }
+    };
+
+    static constexpr size_t toEnd = static_cast<size_t>(-1);
+
+    BasicBitView() noexcept : data_(nullptr), offset_(0), size_(0) {}
+    BasicBitView(Byte* data, size_t bitOffset, size_t size) noexcept;
+
+    template<typename Allocator>
+    BasicBitView(Vector<bool, Allocator>& vector) noexcept;
+
+    template<typename Allocator, typename U = Byte, typename = std::enable_if_t<std::is_const<U>::value> >
+    BasicBitView(const Vector<bool, Allocator>& vector) noexcept;
+
+    // BitView -> ConstBitView
+    template<typename U, typename = std::enable_if_t<std::is_same<const U, Byte>::value && !std::is_const<U>::value> >
+    BasicBitView(const BasicBitView<U>& other) noexcept;
+
+    bool at(size_t pos) const;
+    bool operator[](size_t pos) const noexcept;
+
+    // BitView only
+    void set(size_t pos, bool value) const noexcept;
+
+    // Byte holding the first bit, bits before bitOffset() in it belong to someone else
+    Byte*  data     () const noexcept;
+    size_t bitOffset() const noexcept;
+
+    Iterator begin() const noexcept;
+    Iterator end  () const noexcept;
+
+    bool   empty() const noexcept;
+    size_t size () const noexcept;
+
+    BasicBitView subview(size_t offset, size_t count = toEnd) const;
+};
+
+using BitView      = BasicBitView<uint8_t>;
+using ConstBitView = BasicBitView<const uint8_t>;
+
+// --------------------------Implementation-----------------------------------
+
+namespace
+{
+
+inline void checkViewRange(size_t offset, size_t size)
+{
+    if (offset > size)
+    {
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::VectorIndexOutOfBounds,
+            "Subview starts after the end of view",
+            {}
+        );
+    }
+}
+
+inline void checkViewIndex(size_t pos, size_t size)
+{
+    if (pos >= size)
+    {
+        THROW_EXCEPTION_WITH_REASON(
+            StdErrors::VectorIndexOutOfBounds,
+            "View index out of bounds",
+            {}
+        );
+    }
+}
+
+} // namespace anon
+
+template<typename T>
+template<typename Allocator>
+VectorView<T>::VectorView(Vector<ValueType, Allocator>& vector) noexcept : data_(vector.data()), size_(vector.size())
+{
+}
+
+template<typename T>
+template<typename Allocator, typename U, typename>
+VectorView<T>::VectorView(const Vector<ValueType, Allocator>& vector) noexcept :
+    data_(vector.data()), size_(vector.size())
+{
+}
+
+template<typename T>
+template<typename U, typename>
+VectorView<T>::VectorView(const VectorView<U>& other) noexcept : data_(other.data()), size_(other.size())
+{
+}
+
+template<typename T>
+T& VectorView<T>::at(size_t pos) const
+{
+    checkViewIndex(pos, size_);
+
+    return data_[pos];
+}
+
+template<typename T>
+T& VectorView<T>::operator[](size_t pos) const noexcept
+{
+    return data_[pos];
+}
+
+template<typename T>
+T& VectorView<T>::front() const noexcept
+{
+    return data_[0];
+}
+
+template<typename T>
+T& VectorView<T>::back() const noexcept
+{
+    return data_[size_ - 1];
+}
+
+template<typename T>
+T* VectorView<T>::data() const noexcept
+{
+    return data_;
+}
+
+template<typename T>
+typename VectorView<T>::Iterator VectorView<T>::begin() const noexcept
+{
+    return Iterator{data_};
+}
+
+template<typename T>
+typename VectorView<T>::Iterator VectorView<T>::end() const noexcept
+{
+    return Iterator{data_ + size_};
+}
+
+template<typename T>
+bool VectorView<T>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename T>
+size_t VectorView<T>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename T>
+VectorView<T> VectorView<T>::subview(size_t offset, size_t count) const
+{
+    checkViewRange(offset, size_);
+
+    return VectorView{data_ + offset, std::min(count, size_ - offset)};
+}
+
+template<typename Byte>
+BasicBitView<Byte>::BasicBitView(Byte* data, size_t bitOffset, size_t size) noexcept :
+    data_(data + getBlock(bitOffset)), offset_(getShift(bitOffset)), size_(size)
+{
+}
+
+template<typename Byte>
+template<typename Allocator>
+BasicBitView<Byte>::BasicBitView(Vector<bool, Allocator>& vector) noexcept :
+    data_(vector.data()), offset_(0), size_(vector.size())
+{
+}
+
+template<typename Byte>
+template<typename Allocator, typename U, typename>
+BasicBitView<Byte>::BasicBitView(const Vector<bool, Allocator>& vector) noexcept :
+    data_(vector.data()), offset_(0), size_(vector.size())
+{
+}
+
+template<typename Byte>
+template<typename U, typename>
+BasicBitView<Byte>::BasicBitView(const BasicBitView<U>& other) noexcept :
+    data_(other.data()), offset_(other.bitOffset()), size_(other.size())
+{
+}
+
+template<typename Byte>
+bool BasicBitView<Byte>::at(size_t pos) const
+{
+    checkViewIndex(pos, size_);
+
+    return (*this)[pos];
+}
+
+template<typename Byte>
+bool BasicBitView<Byte>::operator[](size_t pos) const noexcept
+{
+    return getBit(data_, offset_ + pos);
+}
+
+template<typename Byte>
+void BasicBitView<Byte>::set(size_t pos, bool value) const noexcept
+{
+    static_assert(!std::is_const<Byte>::value, "can't write through ConstBitView");
+
+    setBit(data_, offset_ + pos, value);
+}
+
+template<typename Byte>
+Byte* BasicBitView<Byte>::data() const noexcept
+{
+    return data_;
+}
+
+template<typename Byte>
+size_t BasicBitView<Byte>::bitOffset() const noexcept
+{
+    return offset_;
+}
+
+template<typename Byte>
+typename BasicBitView<Byte>::Iterator BasicBitView<Byte>::begin() const noexcept
+{
+    return Iterator{data_, offset_};
+}
+
+template<typename Byte>
+typename BasicBitView<Byte>::Iterator BasicBitView<Byte>::end() const noexcept
+{
+    return Iterator{data_, offset_ + size_};
+}
+
+template<typename Byte>
+bool BasicBitView<Byte>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template<typename Byte>
+size_t BasicBitView<Byte>::size() const noexcept
+{
+    return size_;
+}
+
+template<typename Byte>
+BasicBitView<Byte> BasicBitView<Byte>::subview(size_t offset, size_t count) const
+{
+    checkViewRange(offset, size_);
+
+    return BasicBitView{data_, offset_ + offset, std::min(count, size_ - offset)};
+}
+
+} // namespace MyStd
+
+#endif // VECTOR_VIEW_HPP
@@ -0,0 +1,122 @@
+#include "Parallel/BufferReclaimer.hpp"
+
+#include <system_error>
+
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+BufferReclaimer::BufferReclaimer(size_t queueDepth) :
+    mutex_(), hasWork_(), drained_(), buffers_(), queueDepth_(queueDepth), reclaimed_(0),
+    busy_(false), stop_(false), thread_()
+{
+    try
+    {
+        thread_ = std::thread{&BufferReclaimer::reclaimLoop, this};
+    }
+    catch (std::system_error&)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::ReclaimerCtorErr,
+            "Failed to start reclaimer thread",
+            {}
+        );
+    }
+}
+
+BufferReclaimer::~BufferReclaimer()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+    }
+
+    hasWork_.notify_one();
+    thread_.join();
+}
+
+size_t BufferReclaimer::queueDepth() const noexcept
+{
+    return queueDepth_;
+}
+
+size_t BufferReclaimer::reclaimedCount() const
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    return reclaimed_;
+}
+
+void BufferReclaimer::retire(char* buffer) noexcept
+{
+    if (!buffer)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        if (buffers_.size() < queueDepth_)
+        {
+            try
+            {
+                buffers_.push_back(buffer);
+                buffer = nullptr;
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    // Queue is full or couldn't grow, the caller pays for this one
+    if (buffer)
+    {
+        delete [] buffer;
+        return;
+    }
+
+    hasWork_.notify_one();
+}
+
+void BufferReclaimer::flush()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    drained_.wait(lock, [this]() { return buffers_.empty() && !busy_; });
+}
+
+BufferReclaimer& BufferReclaimer::defaultReclaimer()
+{
+    static BufferReclaimer* reclaimer = new BufferReclaimer{};
+    return *reclaimer;
+}
+
+// ------------------------------Private------------------------------
+
+void BufferReclaimer::reclaimLoop()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    while (true)
+    {
+        hasWork_.wait(lock, [this]() { return stop_ || !buffers_.empty(); });
+
+        if (buffers_.empty())
+            return;
+
+        char* buffer = buffers_.front();
+        buffers_.pop_front();
+        busy_ = true;
+
+        lock.unlock();
+        delete [] buffer;
+        lock.lock();
+
+        busy_ = false;
+        ++reclaimed_;
+
+        if (buffers_.empty())
+            drained_.notify_all();
+    }
+}
+
+} // namespace MyStd
@@ -1,102 +1,175 @@
 #include "Exceptions.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
 namespace MyStd
 {
 
-ExceptionWithReason::ExceptionWithReason() noexcept
+namespace
 {
-}
 
-ExceptionWithReason::ExceptionWithReason(
-    StdErrors error, const char* reason, ExceptionWithReason&& prevException
-) noexcept
+const char messageHeader[] = "Exception occurred. Reasons:\n";
+
+// Returns number of chars the frame takes, writes at most bufferSize - 1 of them like snprintf
+size_t formatFrame(char* buffer, size_t bufferSize, size_t reasonId, const ExceptionWithReason::Frame& frame) noexcept
 {
-    ExceptionWithReason* storageForPrevException = nullptr;
+    int length = 0;
 
-    try
+    if (frame.function)
     {
-        storageForPrevException = new ExceptionWithReason(std::move(prevException));
+        length = snprintf(
+            buffer, bufferSize, "%zu. %s Occurred in func %s, file %s, line %zu. Error code - %d\n",
+            reasonId, frame.reason, frame.function, frame.file, frame.line, static_cast<int>(frame.error)
+        );
     }
-    catch (std::bad_alloc)
+    else
     {
-        fprintf(stderr, "CAUGHT BAD ALLOC WHILE CREATING NEXT EXCEPTION\n. Terminating.\n");
-        fprintf(stderr, "%s", prevException.what());
-
-        std::terminate();
+        length = snprintf(
+            buffer, bufferSize, "%zu. %s Error code - %d\n", reasonId, frame.reason, static_cast<int>(frame.error)
+        );
     }
-    catch (...)
-    {
-        fprintf(stderr, "UNKNOWN EXCEPTION CAUGHT WHILE CREATING NEXT EXCEPTION\n. Terminating.\n");
-        fprintf(stderr, "%s", prevException.what());
 
-        std::terminate();
-    }
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
 
-    assert(storageForPrevException);
+} // namespace anon
 
-    prevException_.reset(storageForPrevException);
-    reasonString_.reset(strdup(reason));
-    error_ = error;
+ExceptionWithReason::ExceptionWithReason() noexcept : frames_(), framesCount_(0), droppedFrames_(0), message_(nullptr)
+{
+}
+
+ExceptionWithReason::ExceptionWithReason(
+    StdErrors error, const char* reason, ExceptionWithReason&& prevException
+) noexcept : ExceptionWithReason(error, reason, std::move(prevException), nullptr, nullptr, 0)
+{
 }
 
 ExceptionWithReason::ExceptionWithReason(
     StdErrors error, const char* reason, ExceptionWithReason&& prevException,
     const char* funcWithErr, const char* fileWithErr, const size_t lineWithErr
-) noexcept
+) noexcept : frames_(), framesCount_(1), droppedFrames_(prevException.droppedFrames_), message_(nullptr)
 {
-    static const size_t bufferForReasonSize = 1024;
-    static char extendedReason[bufferForReasonSize] = "";
-
-    snprintf(
-        extendedReason, bufferForReasonSize, "%s Occurred in func %s, file %s, line %zu", 
-        reason, funcWithErr, fileWithErr, lineWithErr
-    );
-    
-    *this = ExceptionWithReason{error, extendedReason, std::move(prevException)};
+    frames_[0] = Frame{error, reason, funcWithErr, fileWithErr, lineWithErr};
+
+    size_t causesCount = prevException.framesCount_;
+
+    if (causesCount < maxChainLength)
+    {
+        memcpy(frames_ + 1, prevException.frames_, causesCount * sizeof(Frame));
+        framesCount_ += causesCount;
+
+        return;
+    }
+
+    // Chain is full: the middle is dropped, the root cause in the last frame is always kept
+    memcpy(frames_ + 1, prevException.frames_, (maxChainLength - 2) * sizeof(Frame));
+    frames_[maxChainLength - 1] = prevException.frames_[causesCount - 1];
+
+    framesCount_    = maxChainLength;
+    droppedFrames_ += causesCount - (maxChainLength - 2) - 1;
 }
 
-ExceptionWithReason::ExceptionWithReason(ExceptionWithReason&& other) noexcept
+ExceptionWithReason::ExceptionWithReason(ExceptionWithReason&& other) noexcept :
+    frames_(), framesCount_(other.framesCount_), droppedFrames_(other.droppedFrames_),
+    message_(other.message_.exchange(nullptr, std::memory_order_acquire))
 {
-    error_ = other.error_;
-    reasonString_.reset(other.reasonString_.release());
-    prevException_.reset(other.prevException_.release());
+    memcpy(frames_, other.frames_, framesCount_ * sizeof(Frame));
 }
 
 ExceptionWithReason& ExceptionWithReason::operator=(ExceptionWithReason&& other) noexcept
 {
-    error_ = other.error_;
-    reasonString_.reset(other.reasonString_.release());
-    prevException_.reset(other.prevException_.release());
+    memcpy(frames_, other.frames_, other.framesCount_ * sizeof(Frame));
+
+    framesCount_   = other.framesCount_;
+    droppedFrames_ = other.droppedFrames_;
+
+    delete[] message_.exchange(other.message_.exchange(nullptr, std::memory_order_acquire), std::memory_order_acq_rel);
 
     return *this;
 }
 
+ExceptionWithReason::~ExceptionWithReason()
+{
+    delete[] message_.load(std::memory_order_acquire);
+}
+
+StdErrors ExceptionWithReason::error() const noexcept
+{
+    return framesCount_ ? frames_[0].error : StdErrors::Ok;
+}
+
+size_t ExceptionWithReason::chainLength() const noexcept
+{
+    return framesCount_;
+}
+
+const ExceptionWithReason::Frame& ExceptionWithReason::frame(size_t pos) const noexcept
+{
+    return frames_[pos];
+}
+
 const char* ExceptionWithReason::what() const noexcept
 {
-    const ExceptionWithReason* exceptionNow = this;
+    if (const char* formatted = message_.load(std::memory_order_acquire))
+        return formatted;
 
-    fprintf(stderr, "Exception occurred. Reasons:\n");
+    static const char droppedFormat[] = "... %zu more\n";
 
-    size_t reasonId = 0;
-    const char* reason = nullptr;
+    // Dropped frames are somewhere between the last kept one and the root cause
+    size_t rootId = framesCount_ - 1;
 
-    while (exceptionNow)
+    size_t length = sizeof(messageHeader) - 1;
+    for (size_t frameId = 0; frameId < framesCount_; ++frameId)
     {
-        reason = exceptionNow->reasonString_.get();
+        size_t reasonId = frameId == rootId ? frameId + droppedFrames_ : frameId;
+        length += formatFrame(nullptr, 0, reasonId, frames_[frameId]);
+    }
+
+    if (droppedFrames_)
+        length += static_cast<size_t>(snprintf(nullptr, 0, droppedFormat, droppedFrames_));
 
-        if (reason) 
+    char* message = new (std::nothrow) char[length + 1];
+
+    if (!message)
+        return framesCount_ ? frames_[0].reason : "";
+
+    char* pos = message;
+    char* end = message + length + 1;
+
+    memcpy(pos, messageHeader, sizeof(messageHeader));
+    pos += sizeof(messageHeader) - 1;
+
+    for (size_t frameId = 0; frameId < framesCount_; ++frameId)
+    {
+        size_t reasonId = frameId;
+
+        if (frameId == rootId && droppedFrames_)
         {
-            fprintf(
-                stderr, "%zu. %s Error code - %d\n", reasonId, reason, static_cast<int>(exceptionNow->error_)
-            );
-            
-            reasonId++;
+            pos      += snprintf(pos, static_cast<size_t>(end - pos), droppedFormat, droppedFrames_);
+            reasonId += droppedFrames_;
         }
 
-        exceptionNow = exceptionNow->prevException_.get();
+        pos += formatFrame(pos, static_cast<size_t>(end - pos), reasonId, frames_[frameId]);
     }
 
-    return "";
+    char* expected = nullptr;
+    if (!message_.compare_exchange_strong(expected, message, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        // Another thread published the same text first
+        delete[] message;
+        return expected;
+    }
+
+    return message;
+}
+
+void terminateWithException(ExceptionWithReason&& exception) noexcept
+{
+    fputs(exception.what(), stderr);
+    std::abort();
 }
 
 } // namespace MyStd
@@ -0,0 +1,124 @@
+#include "Serialization/FdIo.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#include <unistd.h>
+
+namespace MyStd
+{
+
+namespace
+{
+
+// Large transfers are split so a single syscall never hits the kernel's per-call limit
+const size_t maxFdIoChunk = 1 << 30;
+
+// One read, retried on EINTR. got is 0 at the end of stream
+StdErrors tryReadOnce(int fd, uint8_t* data, size_t bytes, size_t& got) noexcept
+{
+    while (true)
+    {
+        ssize_t result = ::read(fd, data, std::min(bytes, maxFdIoChunk));
+
+        if (result >= 0)
+        {
+            got = static_cast<size_t>(result);
+            return StdErrors::Ok;
+        }
+
+        if (errno != EINTR)
+            return StdErrors::FdIoErr;
+    }
+}
+
+size_t readOnce(int fd, uint8_t* data, size_t bytes)
+{
+    size_t got = 0;
+
+    if (tryReadOnce(fd, data, bytes, got) != StdErrors::Ok)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::FdIoErr,
+            "Failed to read from file descriptor",
+            {}
+        );
+    }
+
+    return got;
+}
+
+} // namespace anon
+
+FdReadResult readBytes(int fd, void* data, size_t maxBytes, size_t granularity)
+{
+    uint8_t* pos = static_cast<uint8_t*>(data);
+
+    size_t done  = readOnce(fd, pos, maxBytes);
+    size_t whole = done / granularity;
+
+    // Whatever the first read returned is kept, only the started piece is completed.
+    // From here on the stream has lost bytes, so failures are reported instead of thrown
+    size_t target = (whole + (done % granularity != 0)) * granularity;
+    while (done < target)
+    {
+        size_t got = 0;
+
+        if (tryReadOnce(fd, pos + done, target - done, got) != StdErrors::Ok || got == 0)
+            return FdReadResult{whole, StdErrors::FdIoErr};
+
+        done += got;
+    }
+
+    return FdReadResult{done / granularity, StdErrors::Ok};
+}
+
+void readBytesExactly(int fd, void* data, size_t bytes)
+{
+    uint8_t* pos  = static_cast<uint8_t*>(data);
+    size_t   done = 0;
+
+    while (done < bytes)
+    {
+        size_t got = readOnce(fd, pos + done, bytes - done);
+
+        if (got == 0)
+        {
+            throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                StdErrors::FdIoErr,
+                "Stream ended before all requested bytes were read",
+                {}
+            );
+        }
+
+        done += got;
+    }
+}
+
+void writeBytes(int fd, const void* data, size_t bytes)
+{
+    const uint8_t* pos  = static_cast<const uint8_t*>(data);
+    size_t         done = 0;
+
+    while (done < bytes)
+    {
+        ssize_t written = ::write(fd, pos + done, std::min(bytes - done, maxFdIoChunk));
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                StdErrors::FdIoErr,
+                "Failed to write to file descriptor",
+                {}
+            );
+        }
+
+        done += static_cast<size_t>(written);
+    }
+}
+
+} // namespace MyStd
@@ -0,0 +1,372 @@
+#include "Simd/SimdKernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace MyStd
+{
+
+namespace Simd
+{
+
+namespace
+{
+
+template<typename T>
+struct KernelTable
+{
+    T      (*sum)   (const T* data, size_t size) noexcept;
+    T      (*dot)   (const T* lhs, const T* rhs, size_t size) noexcept;
+    size_t (*argMin)(const T* data, size_t size) noexcept;
+    size_t (*argMax)(const T* data, size_t size) noexcept;
+    size_t (*find)  (const T* data, size_t size, T value) noexcept;
+    size_t (*count) (const T* data, size_t size, T value) noexcept;
+    void   (*scale) (T* data, size_t size, T factor) noexcept;
+    void   (*add)   (T* dst, const T* src, size_t size) noexcept;
+    void   (*fma)   (T* dst, const T* lhs, const T* rhs, size_t size) noexcept;
+};
+
+template<typename T>
+struct LaneIndex;
+
+template<>
+struct LaneIndex<float>
+{
+    using Type = int32_t;
+    static constexpr size_t blockSize = size_t(1) << 30;
+};
+
+template<>
+struct LaneIndex<int32_t> : LaneIndex<float> {};
+
+template<>
+struct LaneIndex<double>
+{
+    using Type = int64_t;
+    static constexpr size_t blockSize = static_cast<size_t>(INT64_MAX);
+};
+
+template<>
+struct LaneIndex<int64_t> : LaneIndex<double> {};
+
+// find and count look for exact matches, so comparing floats with == is intended here
+template<typename T>
+inline bool isSameValue(T lhs, T rhs) noexcept
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+    return lhs == rhs;
+#pragma GCC diagnostic pop
+}
+
+// Value pos of packed bits wide values, may span two words
+inline uint32_t packedValue(const uint64_t* words, size_t wordsCount, unsigned bits, size_t pos) noexcept
+{
+    size_t bitPos = pos * bits;
+    size_t word   = bitPos / 64;
+    size_t shift  = bitPos % 64;
+
+    uint64_t value = words[word] >> shift;
+    if (shift + bits > 64 && word + 1 < wordsCount)
+        value |= words[word + 1] << (64 - shift);
+
+    return static_cast<uint32_t>(value & ((uint64_t(1) << bits) - 1));
+}
+
+using UnpackBitsKernel =
+    void (*)(const uint64_t* words, size_t wordsCount, unsigned bits, size_t first, size_t count, uint32_t* out)
+    noexcept;
+
+namespace Scalar
+{
+
+template<typename T>
+T sum(const T* data, size_t size) noexcept
+{
+    T result = 0;
+    for (size_t pos = 0; pos < size; ++pos)
+        result += data[pos];
+
+    return result;
+}
+
+template<typename T>
+T dot(const T* lhs, const T* rhs, size_t size) noexcept
+{
+    T result = 0;
+    for (size_t pos = 0; pos < size; ++pos)
+        result += lhs[pos] * rhs[pos];
+
+    return result;
+}
+
+template<typename T>
+size_t argMin(const T* data, size_t size) noexcept
+{
+    return static_cast<size_t>(std::min_element(data, data + size) - data);
+}
+
+template<typename T>
+size_t argMax(const T* data, size_t size) noexcept
+{
+    // max_element returns the first maximum too
+    return static_cast<size_t>(std::max_element(data, data + size) - data);
+}
+
+template<typename T>
+size_t find(const T* data, size_t size, T value) noexcept
+{
+    return static_cast<size_t>(std::find(data, data + size, value) - data);
+}
+
+template<typename T>
+size_t count(const T* data, size_t size, T value) noexcept
+{
+    return static_cast<size_t>(std::count(data, data + size, value));
+}
+
+template<typename T>
+void scale(T* data, size_t size, T factor) noexcept
+{
+    for (size_t pos = 0; pos < size; ++pos)
+        data[pos] *= factor;
+}
+
+template<typename T>
+void add(T* dst, const T* src, size_t size) noexcept
+{
+    for (size_t pos = 0; pos < size; ++pos)
+        dst[pos] += src[pos];
+}
+
+template<typename T>
+void fma(T* dst, const T* lhs, const T* rhs, size_t size) noexcept
+{
+    for (size_t pos = 0; pos < size; ++pos)
+        dst[pos] += lhs[pos] * rhs[pos];
+}
+
+void unpackBits(
+    const uint64_t* words, size_t wordsCount, unsigned bits, size_t first, size_t count, uint32_t* out
+) noexcept
+{
+    for (size_t pos = 0; pos < count; ++pos)
+        out[pos] = packedValue(words, wordsCount, bits, first + pos);
+}
+
+template<typename T>
+KernelTable<T> makeKernelTable() noexcept
+{
+    return KernelTable<T>{sum<T>, dot<T>, argMin<T>, argMax<T>, find<T>, count<T>, scale<T>, add<T>, fma<T>};
+}
+
+} // namespace Scalar
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#define SIMD_KERNELS_X86
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#define SIMD_ISA_NAMESPACE Sse2
+#define SIMD_VECTOR_BYTES  16
+#include "SimdKernelsIsa.hpp"
+#undef SIMD_ISA_NAMESPACE
+#undef SIMD_VECTOR_BYTES
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#define SIMD_ISA_NAMESPACE Avx2
+#define SIMD_VECTOR_BYTES  32
+#include "SimdKernelsIsa.hpp"
+#undef SIMD_ISA_NAMESPACE
+#undef SIMD_VECTOR_BYTES
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512dq")
+#define SIMD_ISA_NAMESPACE Avx512
+#define SIMD_VECTOR_BYTES  64
+#include "SimdKernelsIsa.hpp"
+#undef SIMD_ISA_NAMESPACE
+#undef SIMD_VECTOR_BYTES
+#pragma GCC pop_options
+
+#endif // x86
+
+const size_t simdLevelsCount = static_cast<size_t>(SimdLevel::Avx512) + 1;
+
+template<typename T>
+struct KernelTables
+{
+    KernelTable<T> tables[simdLevelsCount];
+
+    KernelTables() noexcept : tables()
+    {
+        for (KernelTable<T>& table : tables)
+            table = Scalar::makeKernelTable<T>();
+
+#ifdef SIMD_KERNELS_X86
+        tables[static_cast<size_t>(SimdLevel::Sse2)]   = Sse2::makeKernelTable<T>();
+        tables[static_cast<size_t>(SimdLevel::Avx2)]   = Avx2::makeKernelTable<T>();
+        tables[static_cast<size_t>(SimdLevel::Avx512)] = Avx512::makeKernelTable<T>();
+#endif
+    }
+};
+
+struct UnpackBitsKernels
+{
+    UnpackBitsKernel kernels[simdLevelsCount];
+
+    UnpackBitsKernels() noexcept : kernels()
+    {
+        for (UnpackBitsKernel& kernel : kernels)
+            kernel = Scalar::unpackBits;
+
+#ifdef SIMD_KERNELS_X86
+        kernels[static_cast<size_t>(SimdLevel::Sse2)]   = Sse2::unpackBits;
+        kernels[static_cast<size_t>(SimdLevel::Avx2)]   = Avx2::unpackBits;
+        kernels[static_cast<size_t>(SimdLevel::Avx512)] = Avx512::unpackBits;
+#endif
+    }
+};
+
+SimdLevel detectSimdLevel() noexcept
+{
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+        return SimdLevel::Avx512;
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SimdLevel::Avx2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::Sse2;
+#endif
+
+    return SimdLevel::Scalar;
+}
+
+std::atomic<SimdLevel>& currentLevel() noexcept
+{
+    static std::atomic<SimdLevel> level{detectedSimdLevel()};
+    return level;
+}
+
+template<typename T>
+const KernelTable<T>& kernels() noexcept
+{
+    static const KernelTables<T> tables;
+    return tables.tables[static_cast<size_t>(currentLevel().load(std::memory_order_relaxed))];
+}
+
+UnpackBitsKernel unpackBitsKernel() noexcept
+{
+    static const UnpackBitsKernels kernels;
+    return kernels.kernels[static_cast<size_t>(currentLevel().load(std::memory_order_relaxed))];
+}
+
+} // namespace anon
+
+template<typename T>
+T sum(const T* data, size_t size) noexcept
+{
+    return kernels<T>().sum(data, size);
+}
+
+template<typename T>
+T dot(const T* lhs, const T* rhs, size_t size) noexcept
+{
+    return kernels<T>().dot(lhs, rhs, size);
+}
+
+template<typename T>
+size_t argMin(const T* data, size_t size) noexcept
+{
+    return kernels<T>().argMin(data, size);
+}
+
+template<typename T>
+size_t argMax(const T* data, size_t size) noexcept
+{
+    return kernels<T>().argMax(data, size);
+}
+
+template<typename T>
+size_t find(const T* data, size_t size, T value) noexcept
+{
+    return kernels<T>().find(data, size, value);
+}
+
+template<typename T>
+size_t count(const T* data, size_t size, T value) noexcept
+{
+    return kernels<T>().count(data, size, value);
+}
+
+template<typename T>
+void scale(T* data, size_t size, T factor) noexcept
+{
+    kernels<T>().scale(data, size, factor);
+}
+
+template<typename T>
+void add(T* dst, const T* src, size_t size) noexcept
+{
+    kernels<T>().add(dst, src, size);
+}
+
+template<typename T>
+void fma(T* dst, const T* lhs, const T* rhs, size_t size) noexcept
+{
+    kernels<T>().fma(dst, lhs, rhs, size);
+}
+
+void unpackBits(
+    const uint64_t* words, size_t wordsCount, unsigned bits, size_t first, size_t count, uint32_t* out
+) noexcept
+{
+    unpackBitsKernel()(words, wordsCount, bits, first, count, out);
+}
+
+#define INSTANTIATE_SIMD_KERNELS(TYPE) \
+    template TYPE   sum   (const TYPE* data, size_t size) noexcept; \
+    template TYPE   dot   (const TYPE* lhs, const TYPE* rhs, size_t size) noexcept; \
+    template size_t argMin(const TYPE* data, size_t size) noexcept; \
+    template size_t argMax(const TYPE* data, size_t size) noexcept; \
+    template size_t find  (const TYPE* data, size_t size, TYPE value) noexcept; \
+    template size_t count (const TYPE* data, size_t size, TYPE value) noexcept; \
+    template void   scale (TYPE* data, size_t size, TYPE factor) noexcept; \
+    template void   add   (TYPE* dst, const TYPE* src, size_t size) noexcept; \
+    template void   fma   (TYPE* dst, const TYPE* lhs, const TYPE* rhs, size_t size) noexcept;
+
+INSTANTIATE_SIMD_KERNELS(float)
+INSTANTIATE_SIMD_KERNELS(double)
+INSTANTIATE_SIMD_KERNELS(int32_t)
+INSTANTIATE_SIMD_KERNELS(int64_t)
+
+#undef INSTANTIATE_SIMD_KERNELS
+
+} // namespace Simd
+
+SimdLevel detectedSimdLevel() noexcept
+{
+    static const SimdLevel level = Simd::detectSimdLevel();
+    return level;
+}
+
+SimdLevel activeSimdLevel() noexcept
+{
+    return Simd::currentLevel().load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(SimdLevel level) noexcept
+{
+    Simd::currentLevel().store(std::min(level, detectedSimdLevel()), std::memory_order_relaxed);
+}
+
+} // namespace MyStd
@@ -0,0 +1,344 @@
+// Kernel bodies shared by every simd level. No include guard: SimdKernels.cpp includes this file once per level
+// inside a "#pragma GCC target" region, with SIMD_ISA_NAMESPACE and SIMD_VECTOR_BYTES defined.
+
+namespace SIMD_ISA_NAMESPACE
+{
+
+template<typename T>
+struct Lanes
+{
+    typedef T Type __attribute__((vector_size(SIMD_VECTOR_BYTES)));
+
+    static constexpr size_t count = SIMD_VECTOR_BYTES / sizeof(T);
+};
+
+template<typename T>
+using LaneVector = typename Lanes<T>::Type;
+
+// Lane indices use the same width as T so comparison masks can select them directly
+template<typename T>
+using IndexVector = LaneVector<typename LaneIndex<T>::Type>;
+
+template<typename T>
+inline LaneVector<T> load(const T* data) noexcept
+{
+    LaneVector<T> vector;
+    memcpy(&vector, data, sizeof(vector));
+    return vector;
+}
+
+template<typename T>
+inline void store(T* data, const LaneVector<T>& vector) noexcept
+{
+    memcpy(data, &vector, sizeof(vector));
+}
+
+template<typename T>
+inline LaneVector<T> broadcast(T value) noexcept
+{
+    LaneVector<T> vector = {};
+    return vector + value;
+}
+
+template<typename T>
+inline IndexVector<T> laneIds() noexcept
+{
+    IndexVector<T> ids = {};
+    for (size_t lane = 0; lane < Lanes<T>::count; ++lane)
+        ids[lane] = static_cast<typename LaneIndex<T>::Type>(lane);
+
+    return ids;
+}
+
+template<typename T>
+inline T horizontalSum(const LaneVector<T>& vector) noexcept
+{
+    T result = 0;
+    for (size_t lane = 0; lane < Lanes<T>::count; ++lane)
+        result += vector[lane];
+
+    return result;
+}
+
+template<typename Mask>
+inline bool anyLane(const Mask& mask) noexcept
+{
+    uint64_t words[sizeof(Mask) / sizeof(uint64_t)];
+    memcpy(words, &mask, sizeof(Mask));
+
+    uint64_t result = 0;
+    for (uint64_t word : words)
+        result |= word;
+
+    return result != 0;
+}
+
+template<typename T>
+T sum(const T* data, size_t size) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+
+    LaneVector<T> acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+
+    size_t pos = 0;
+    for (; pos + 4 * lanes <= size; pos += 4 * lanes)
+    {
+        acc0 += load(data + pos);
+        acc1 += load(data + pos + lanes);
+        acc2 += load(data + pos + 2 * lanes);
+        acc3 += load(data + pos + 3 * lanes);
+    }
+
+    for (; pos + lanes <= size; pos += lanes)
+        acc0 += load(data + pos);
+
+    T result = horizontalSum<T>((acc0 + acc1) + (acc2 + acc3));
+    for (; pos < size; ++pos)
+        result += data[pos];
+
+    return result;
+}
+
+template<typename T>
+T dot(const T* lhs, const T* rhs, size_t size) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+
+    LaneVector<T> acc0 = {}, acc1 = {};
+
+    size_t pos = 0;
+    for (; pos + 2 * lanes <= size; pos += 2 * lanes)
+    {
+        acc0 += load(lhs + pos) * load(rhs + pos);
+        acc1 += load(lhs + pos + lanes) * load(rhs + pos + lanes);
+    }
+
+    for (; pos + lanes <= size; pos += lanes)
+        acc0 += load(lhs + pos) * load(rhs + pos);
+
+    T result = horizontalSum<T>(acc0 + acc1);
+    for (; pos < size; ++pos)
+        result += lhs[pos] * rhs[pos];
+
+    return result;
+}
+
+// Less is "<" for argMin and ">" for argMax. Lane indices are relative to a block so 32-bit lanes can't overflow.
+template<typename T, typename Less>
+size_t argExtremum(const T* data, size_t size, Less less) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+
+    if (size < lanes)
+    {
+        size_t best = 0;
+        for (size_t pos = 1; pos < size; ++pos)
+        {
+            if (less(data[pos], data[best]))
+                best = pos;
+        }
+
+        return best;
+    }
+
+    size_t bestPos = 0;
+
+    for (size_t blockBegin = 0; blockBegin < size; blockBegin += LaneIndex<T>::blockSize)
+    {
+        size_t blockSize = std::min(size - blockBegin, LaneIndex<T>::blockSize);
+        const T* block = data + blockBegin;
+
+        size_t pos = 0;
+        if (blockSize >= lanes)
+        {
+            LaneVector<T>  bestValues  = load(block);
+            IndexVector<T> ids         = laneIds<T>();
+            IndexVector<T> bestIds     = ids;
+            IndexVector<T> step        = ids - ids + static_cast<typename LaneIndex<T>::Type>(lanes);
+
+            for (pos = lanes; pos + lanes <= blockSize; pos += lanes)
+            {
+                LaneVector<T> values = load(block + pos);
+                ids += step;
+
+                auto better = less(values, bestValues);
+                bestValues  = better ? values : bestValues;
+                bestIds     = better ? ids    : bestIds;
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                size_t lanePos = blockBegin + static_cast<size_t>(bestIds[lane]);
+                if (less(data[lanePos], data[bestPos]) || (!less(data[bestPos], data[lanePos]) && lanePos < bestPos))
+                    bestPos = lanePos;
+            }
+        }
+
+        for (; pos < blockSize; ++pos)
+        {
+            if (less(block[pos], data[bestPos]))
+                bestPos = blockBegin + pos;
+        }
+    }
+
+    return bestPos;
+}
+
+struct Less
+{
+    template<typename U>
+    auto operator()(const U& lhs, const U& rhs) const noexcept -> decltype(lhs < rhs) { return lhs < rhs; }
+};
+
+struct Greater
+{
+    template<typename U>
+    auto operator()(const U& lhs, const U& rhs) const noexcept -> decltype(lhs > rhs) { return lhs > rhs; }
+};
+
+template<typename T>
+size_t argMin(const T* data, size_t size) noexcept
+{
+    return argExtremum(data, size, Less{});
+}
+
+template<typename T>
+size_t argMax(const T* data, size_t size) noexcept
+{
+    return argExtremum(data, size, Greater{});
+}
+
+template<typename T>
+size_t find(const T* data, size_t size, T value) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+    const LaneVector<T> needle = broadcast(value);
+
+    size_t pos = 0;
+    for (; pos + 2 * lanes <= size; pos += 2 * lanes)
+    {
+        if (anyLane((load(data + pos) == needle) | (load(data + pos + lanes) == needle)))
+            break;
+    }
+
+    for (; pos < size; ++pos)
+    {
+        if (isSameValue(data[pos], value))
+            return pos;
+    }
+
+    return size;
+}
+
+template<typename T>
+size_t count(const T* data, size_t size, T value) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+    const LaneVector<T> needle = broadcast(value);
+
+    size_t result = 0;
+
+    for (size_t blockBegin = 0; blockBegin < size; blockBegin += LaneIndex<T>::blockSize)
+    {
+        size_t blockSize = std::min(size - blockBegin, LaneIndex<T>::blockSize);
+        const T* block = data + blockBegin;
+
+        // Comparison gives -1 in matching lanes
+        IndexVector<T> matches = {};
+
+        size_t pos = 0;
+        for (; pos + lanes <= blockSize; pos += lanes)
+            matches -= (load(block + pos) == needle);
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+            result += static_cast<size_t>(matches[lane]);
+
+        for (; pos < blockSize; ++pos)
+            result += isSameValue(block[pos], value);
+    }
+
+    return result;
+}
+
+template<typename T>
+void scale(T* data, size_t size, T factor) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+    const LaneVector<T> factors = broadcast(factor);
+
+    size_t pos = 0;
+    for (; pos + lanes <= size; pos += lanes)
+        store(data + pos, load(data + pos) * factors);
+
+    for (; pos < size; ++pos)
+        data[pos] *= factor;
+}
+
+template<typename T>
+void add(T* dst, const T* src, size_t size) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+
+    size_t pos = 0;
+    for (; pos + lanes <= size; pos += lanes)
+        store(dst + pos, load(dst + pos) + load(src + pos));
+
+    for (; pos < size; ++pos)
+        dst[pos] += src[pos];
+}
+
+template<typename T>
+void fma(T* dst, const T* lhs, const T* rhs, size_t size) noexcept
+{
+    const size_t lanes = Lanes<T>::count;
+
+    size_t pos = 0;
+    for (; pos + lanes <= size; pos += lanes)
+        store(dst + pos, load(dst + pos) + load(lhs + pos) * load(rhs + pos));
+
+    for (; pos < size; ++pos)
+        dst[pos] += lhs[pos] * rhs[pos];
+}
+
+// One value per 64-bit lane: every lane reads its word and the next one and shifts the value out with per lane
+// counts, then lanes are narrowed to 32 bits. Blocks whose last lane has no next word go to the scalar tail
+inline void unpackBits(
+    const uint64_t* words, size_t wordsCount, unsigned bits, size_t first, size_t count, uint32_t* out
+) noexcept
+{
+    typedef uint32_t NarrowVector __attribute__((vector_size(SIMD_VECTOR_BYTES / 2)));
+
+    const size_t lanes = Lanes<uint64_t>::count;
+    const LaneVector<uint64_t> masks = broadcast<uint64_t>((uint64_t(1) << bits) - 1);
+
+    size_t pos = 0;
+    for (; pos + lanes <= count && (first + pos + lanes - 1) * bits / 64 + 1 < wordsCount; pos += lanes)
+    {
+        LaneVector<uint64_t> low, high, shifts;
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            size_t bitPos = (first + pos + lane) * bits;
+
+            low[lane]    = words[bitPos / 64];
+            high[lane]   = words[bitPos / 64 + 1];
+            shifts[lane] = bitPos % 64;
+        }
+
+        // Two shifts for the high word, a single one by 64 - shift would be undefined for shift == 0
+        LaneVector<uint64_t> values = ((low >> shifts) | ((high << 1) << (63 - shifts))) & masks;
+
+        NarrowVector narrow = __builtin_convertvector(values, NarrowVector);
+        memcpy(out + pos, &narrow, sizeof(narrow));
+    }
+
+    for (; pos < count; ++pos)
+        out[pos] = packedValue(words, wordsCount, bits, first + pos);
+}
+
+template<typename T>
+KernelTable<T> makeKernelTable() noexcept
+{
+    return KernelTable<T>{sum<T>, dot<T>, argMin<T>, argMax<T>, find<T>, count<T>, scale<T>, add<T>, fma<T>};
+}
+
+} // namespace SIMD_ISA_NAMESPACE
@@ -0,0 +1,339 @@
+#include "Serialization/Snapshot.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace MyStd
+{
+
+namespace
+{
+
+// Large reads are split so a single syscall never hits the kernel's per-call limit
+const size_t maxIoChunk = 1 << 30;
+
+const uint64_t checksumMultiplier = 0x9E3779B97F4A7C15ull;
+
+inline uint64_t rotateLeft(uint64_t value, unsigned shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixWord(uint64_t state, uint64_t word)
+{
+    return rotateLeft(state ^ (word * checksumMultiplier), 29) * checksumMultiplier;
+}
+
+void writeAll(int fd, iovec* iov, int iovCount)
+{
+    while (iovCount > 0)
+    {
+        ssize_t written = ::writev(fd, iov, iovCount);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                StdErrors::SnapshotIoErr,
+                "Failed to write snapshot",
+                {}
+            );
+        }
+
+        size_t left = static_cast<size_t>(written);
+        while (iovCount > 0 && left >= iov->iov_len)
+        {
+            left -= iov->iov_len;
+            ++iov;
+            --iovCount;
+        }
+
+        if (iovCount > 0)
+        {
+            iov->iov_base  = static_cast<uint8_t*>(iov->iov_base) + left;
+            iov->iov_len  -= left;
+        }
+    }
+}
+
+// Returns number of bytes read, less than bytes only at the end of file
+size_t readAll(int fd, void* data, size_t bytes)
+{
+    uint8_t* pos  = static_cast<uint8_t*>(data);
+    size_t   done = 0;
+
+    while (done < bytes)
+    {
+        ssize_t got = ::read(fd, pos + done, std::min(bytes - done, maxIoChunk));
+
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                StdErrors::SnapshotIoErr,
+                "Failed to read snapshot",
+                {}
+            );
+        }
+
+        if (got == 0)
+            break;
+
+        done += static_cast<size_t>(got);
+    }
+
+    return done;
+}
+
+// Bytes left after the current position of a regular file, max for pipes and sockets where it is unknown
+uint64_t remainingBytes(int fd) noexcept
+{
+    struct stat info = {};
+
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        return std::numeric_limits<uint64_t>::max();
+
+    off_t pos = ::lseek(fd, 0, SEEK_CUR);
+
+    if (pos < 0)
+        return std::numeric_limits<uint64_t>::max();
+
+    return pos < info.st_size ? static_cast<uint64_t>(info.st_size - pos) : 0;
+}
+
+int openSnapshot(const char* path, int flags)
+{
+    int fd = ::open(path, flags | O_CLOEXEC, 0644);
+
+    if (fd < 0)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::SnapshotIoErr,
+            "Failed to open snapshot file",
+            {}
+        );
+    }
+
+    return fd;
+}
+
+} // namespace anon
+
+SnapshotChecksum::SnapshotChecksum() noexcept : state_(checksumMultiplier), tail_(0), tailSize_(0)
+{
+}
+
+void SnapshotChecksum::update(const void* data, size_t bytes) noexcept
+{
+    const uint8_t* pos = static_cast<const uint8_t*>(data);
+    const uint8_t* end = pos + bytes;
+
+    while (tailSize_ != 0 && pos != end)
+    {
+        tail_ |= uint64_t(*pos++) << (8 * tailSize_);
+
+        if (++tailSize_ == sizeof(uint64_t))
+        {
+            state_    = mixWord(state_, tail_);
+            tail_     = 0;
+            tailSize_ = 0;
+        }
+    }
+
+    for (; end - pos >= static_cast<ptrdiff_t>(sizeof(uint64_t)); pos += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, pos, sizeof(word));
+
+        state_ = mixWord(state_, word);
+    }
+
+    for (; pos != end; ++pos)
+        tail_ |= uint64_t(*pos) << (8 * tailSize_++);
+}
+
+uint64_t SnapshotChecksum::value() const noexcept
+{
+    uint64_t state = tailSize_ == 0 ? state_ : mixWord(state_, tail_);
+
+    return state ^ (state >> 32);
+}
+
+// Buffer is allocated before the file is opened, so a failed allocation can't leak the fd
+SnapshotWriter::SnapshotWriter(const char* path) :
+    fd_(-1), ownsFd_(true), buffer_(new uint8_t[chunkSize]), buffered_(0)
+{
+    fd_ = openSnapshot(path, O_WRONLY | O_CREAT | O_TRUNC);
+}
+
+SnapshotWriter::SnapshotWriter(int fd) : fd_(fd), ownsFd_(false), buffer_(new uint8_t[chunkSize]), buffered_(0)
+{
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    try
+    {
+        flush();
+    }
+    catch (ExceptionWithReason& exception)
+    {
+        fprintf(stderr, "SnapshotWriter lost %zu buffered bytes: %s\n", buffered_, exception.what());
+    }
+
+    if (ownsFd_)
+        ::close(fd_);
+}
+
+void SnapshotWriter::flush()
+{
+    if (buffered_ == 0)
+        return;
+
+    iovec iov = {buffer_.get(), buffered_};
+    writeAll(fd_, &iov, 1);
+
+    buffered_ = 0;
+}
+
+void SnapshotWriter::writeSnapshot(
+    SnapshotKind kind, uint32_t elementSize, uint64_t count, const void* payload, size_t bytes
+)
+{
+    SnapshotChecksum checksum;
+    checksum.update(payload, bytes);
+
+    SnapshotHeader header = {};
+    header.magic       = snapshotMagic;
+    header.version     = snapshotVersion;
+    header.kind        = static_cast<uint16_t>(kind);
+    header.endianness  = snapshotEndiannessMark;
+    header.elementSize = elementSize;
+    header.count       = count;
+    header.checksum    = checksum.value();
+
+    if (buffered_ + sizeof(header) + bytes <= chunkSize)
+    {
+        memcpy(buffer_.get() + buffered_, &header, sizeof(header));
+        buffered_ += sizeof(header);
+
+        if (bytes != 0)
+            memcpy(buffer_.get() + buffered_, payload, bytes);
+        buffered_ += bytes;
+
+        return;
+    }
+
+    // Pending chunk, header and payload leave in one syscall, the payload is never copied
+    iovec iov[3] = {
+        {buffer_.get(),              buffered_},
+        {&header,                    sizeof(header)},
+        {const_cast<void*>(payload), bytes},
+    };
+
+    writeAll(fd_, iov, 3);
+    buffered_ = 0;
+}
+
+SnapshotReader::SnapshotReader(const char* path) : SnapshotReader(openSnapshot(path, O_RDONLY))
+{
+    ownsFd_ = true;
+}
+
+SnapshotReader::SnapshotReader(int fd) : fd_(fd), ownsFd_(false)
+{
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    if (ownsFd_)
+        ::close(fd_);
+}
+
+SnapshotHeader SnapshotReader::readHeader(SnapshotKind kind, uint32_t elementSize)
+{
+    SnapshotHeader header = {};
+
+    if (readAll(fd_, &header, sizeof(header)) != sizeof(header))
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::SnapshotFormatErr,
+            "Snapshot header is truncated",
+            {}
+        );
+    }
+
+    const char* reason = nullptr;
+
+    if (header.magic != snapshotMagic)
+        reason = "Not a snapshot";
+    else if (header.endianness != snapshotEndiannessMark)
+        reason = "Snapshot was written on a machine with different endianness";
+    else if (header.version != snapshotVersion)
+        reason = "Unsupported snapshot version";
+    else if (header.kind != static_cast<uint16_t>(kind))
+        reason = "Snapshot holds a different kind of vector";
+    else if (header.elementSize != elementSize)
+        reason = "Snapshot element size doesn't match";
+    else if (header.count > std::numeric_limits<size_t>::max() / elementSize)
+        reason = "Snapshot element count is too big";
+    else if (payloadBytes(kind, header.count, elementSize) > remainingBytes(fd_))
+        reason = "Snapshot payload is truncated"; // checked before the count sizes any allocation
+
+    if (reason)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::SnapshotFormatErr,
+            reason,
+            {}
+        );
+    }
+
+    return header;
+}
+
+uint64_t SnapshotReader::payloadBytes(SnapshotKind kind, uint64_t count, uint32_t elementSize) noexcept
+{
+    if (kind == SnapshotKind::Bits)
+        return count / __CHAR_BIT__ + (count % __CHAR_BIT__ != 0);
+
+    return count * elementSize;
+}
+
+void SnapshotReader::readPayload(void* data, size_t bytes, uint64_t checksum)
+{
+    if (readAll(fd_, data, bytes) != bytes)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::SnapshotFormatErr,
+            "Snapshot payload is truncated",
+            {}
+        );
+    }
+
+    SnapshotChecksum actual;
+    actual.update(data, bytes);
+
+    if (actual.value() != checksum)
+    {
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::SnapshotChecksumErr,
+            "Snapshot checksum mismatch",
+            {}
+        );
+    }
+}
+
+} // namespace MyStd
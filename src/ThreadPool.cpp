@@ -0,0 +1,249 @@
+#include "Parallel/ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+namespace
+{
+
+const size_t notAWorker = static_cast<size_t>(-1);
+
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorkerId = notAWorker;
+
+struct ParallelForState
+{
+    std::atomic<size_t> remaining;
+
+    std::mutex mutex;
+    std::condition_variable done;
+
+    std::exception_ptr exception;
+
+    explicit ParallelForState(size_t count) : remaining(count), mutex(), done(), exception() {}
+};
+
+} // namespace anon
+
+ThreadPool::ThreadPool(size_t threadsCount) :
+    threads_(), queues_(), queuesCount_(std::max<size_t>(threadsCount, 1)),
+    sleepMutex_(), wakeUp_(), pendingTasks_(0), nextQueue_(0), stop_(false)
+{
+    queues_.reset(new WorkerQueue[queuesCount_]);
+    threads_.reserve(threadsCount);
+
+    try
+    {
+        for (size_t workerId = 0; workerId < threadsCount; ++workerId)
+            threads_.emplace_back(&ThreadPool::workerLoop, this, workerId);
+    }
+    catch (std::system_error&)
+    {
+        stopWorkers();
+
+        throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::ThreadPoolCtorErr,
+            "Failed to start worker thread in thread pool",
+            {}
+        );
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    stopWorkers();
+}
+
+size_t ThreadPool::threadsCount() const noexcept
+{
+    return threads_.size();
+}
+
+void ThreadPool::submit(Task task)
+{
+    // Nobody would ever pick the task up
+    if (threads_.empty())
+    {
+        task();
+        return;
+    }
+
+    size_t queueId = currentPool == this ? currentWorkerId
+                                         : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queuesCount_;
+
+    // Counted before it is visible, so a worker that takes it right away never drives the counter below zero
+    pendingTasks_.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock{queues_[queueId].mutex_};
+        queues_[queueId].tasks_.push_back(std::move(task));
+    }
+
+    std::lock_guard<std::mutex> lock{sleepMutex_};
+    wakeUp_.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t chunksCount, const std::function<void(size_t)>& body)
+{
+    if (chunksCount == 0)
+        return;
+
+    if (chunksCount == 1 || threads_.empty())
+    {
+        for (size_t chunkId = 0; chunkId < chunksCount; ++chunkId)
+            body(chunkId);
+
+        return;
+    }
+
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>(chunksCount);
+
+    for (size_t chunkId = 0; chunkId < chunksCount; ++chunkId)
+    {
+        submit([state, &body, chunkId]()
+        {
+            try
+            {
+                body(chunkId);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                if (!state->exception)
+                    state->exception = std::current_exception();
+            }
+
+            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                state->done.notify_all();
+            }
+        });
+    }
+
+    size_t helperId = currentPool == this ? currentWorkerId : notAWorker;
+
+    while (state->remaining.load(std::memory_order_acquire) != 0)
+    {
+        if (runPendingTask(helperId))
+            continue;
+
+        std::unique_lock<std::mutex> lock{state->mutex};
+        state->done.wait_for(lock, std::chrono::milliseconds(1), [&state]()
+        {
+            return state->remaining.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+ThreadPool& ThreadPool::defaultPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+// ------------------------------Private------------------------------
+
+void ThreadPool::workerLoop(size_t workerId)
+{
+    currentPool     = this;
+    currentWorkerId = workerId;
+
+    while (true)
+    {
+        if (runPendingTask(workerId))
+            continue;
+
+        std::unique_lock<std::mutex> lock{sleepMutex_};
+        wakeUp_.wait(lock, [this]()
+        {
+            return stop_ || pendingTasks_.load(std::memory_order_acquire) != 0;
+        });
+
+        if (stop_ && pendingTasks_.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+bool ThreadPool::tryPop(size_t workerId, Task& task)
+{
+    WorkerQueue& queue = queues_[workerId];
+
+    std::lock_guard<std::mutex> lock{queue.mutex_};
+    if (queue.tasks_.empty())
+        return false;
+
+    task = std::move(queue.tasks_.back());
+    queue.tasks_.pop_back();
+
+    return true;
+}
+
+bool ThreadPool::trySteal(size_t workerId, Task& task)
+{
+    size_t startQueue = workerId == notAWorker ? 0 : workerId + 1;
+
+    for (size_t i = 0; i < queuesCount_; ++i)
+    {
+        size_t victimId = (startQueue + i) % queuesCount_;
+        if (victimId == workerId)
+            continue;
+
+        WorkerQueue& victim = queues_[victimId];
+
+        std::lock_guard<std::mutex> lock{victim.mutex_};
+        if (victim.tasks_.empty())
+            continue;
+
+        task = std::move(victim.tasks_.front());
+        victim.tasks_.pop_front();
+
+        return true;
+    }
+
+    return false;
+}
+
+bool ThreadPool::runPendingTask(size_t workerId)
+{
+    Task task;
+
+    bool found = (workerId != notAWorker && tryPop(workerId, task)) || trySteal(workerId, task);
+    if (!found)
+        return false;
+
+    pendingTasks_.fetch_sub(1, std::memory_order_acq_rel);
+
+    task();
+
+    return true;
+}
+
+void ThreadPool::stopWorkers() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{sleepMutex_};
+        stop_ = true;
+    }
+
+    wakeUp_.notify_all();
+
+    for (std::thread& thread : threads_)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    threads_.clear();
+}
+
+} // namespace MyStd
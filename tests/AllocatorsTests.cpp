@@ -0,0 +1,175 @@
+#include "Tests.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include "Vector.hpp"
+#include "Allocators/CompactAllocator.hpp"
+#include "Allocators/FileMappedAllocator.hpp"
+#include "Parallel/BufferReclaimer.hpp"
+
+using namespace MyStd;
+
+namespace
+{
+
+// Unique file in /tmp, removed when the test ends
+class TemporaryMappedFile final
+{
+    char path_[32];
+
+public:
+    TemporaryMappedFile() : path_("/tmp/mappedTestXXXXXX")
+    {
+        int fd = mkstemp(path_);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    TemporaryMappedFile(const TemporaryMappedFile& other) = delete;
+    TemporaryMappedFile& operator=(const TemporaryMappedFile& other) = delete;
+
+    ~TemporaryMappedFile() { unlink(path_); }
+
+    const char* path() const noexcept { return path_; }
+};
+
+} // namespace anon
+
+TEST_CASE(fileMappedVectorPersistsAcrossOpens)
+{
+    TemporaryMappedFile file;
+
+    {
+        Vector<int64_t, FileMappedAllocator<int64_t> > vector{FileMappedAllocator<int64_t>::create(file.path())};
+
+        for (int64_t i = 0; i < 3000; ++i)
+            vector.pushBack(i * 3);
+    }
+
+    {
+        Vector<int64_t, FileMappedAllocator<int64_t> > reopened{FileMappedAllocator<int64_t>::open(file.path())};
+        TEST_CHECK(reopened.size() == 3000 && reopened[2999] == 2999 * 3);
+
+        // Header gets the new size when the allocator is freed
+        reopened.popBack();
+        reopened.shrinkToFit();
+        TEST_CHECK(reopened.capacity() == 2999 && reopened.back() == 2998 * 3);
+    }
+
+    FileMappedAllocator<int64_t> readOnly = FileMappedAllocator<int64_t>::open(file.path(), FileMapMode::ReadOnly);
+    TEST_CHECK(readOnly.isReadOnly() && readOnly.size() == 2999 && readOnly.capacity() == 2999);
+    TEST_CHECK_THROWS(readOnly.realloc(10), StdErrors::FileMapErr);
+}
+
+TEST_CASE(fileMappedAllocatorLeavesRefusedFileIntact)
+{
+    TemporaryMappedFile file;
+
+    {
+        FileMappedAllocator<int64_t> allocator = FileMappedAllocator<int64_t>::create(file.path(), 4);
+        allocator[0] = 10;
+        allocator[1] = 20;
+    }
+
+    // Same byte layout fits int32_t, only the element size in the header tells them apart
+    TEST_CHECK_THROWS(FileMappedAllocator<int32_t>::open(file.path()), StdErrors::FileMapErr);
+
+    FileMappedAllocator<int64_t> allocator = FileMappedAllocator<int64_t>::open(file.path());
+    TEST_CHECK(allocator.size() == 2 && allocator.capacity() == 4 && allocator[1] == 20);
+
+    TEST_CHECK_THROWS(FileMappedAllocator<int64_t>::open("/nonexistent/mapped"), StdErrors::FileMapErr);
+}
+
+TEST_CASE(compactAllocatorShrinksVectorHeader)
+{
+    static_assert(sizeof(Vector<uint32_t, CompactAllocator<uint32_t> >) <= 16, "no vtable, 32-bit sizes");
+
+    using Neighbours = Vector<uint32_t, CompactAllocator<uint32_t> >;
+
+    Vector<Neighbours> adjacency(100, Neighbours{});
+
+    for (uint32_t from = 0; from < 100; ++from)
+    {
+        for (uint32_t to = 0; to < from % 7; ++to)
+            adjacency[from].pushBack(to);
+    }
+
+    TEST_CHECK(adjacency[13].size() == 6 && adjacency[13][5] == 5 && adjacency[14].empty());
+
+    Neighbours copy = adjacency[13];
+    copy.resize(10, 42);
+    copy.shrinkToFit();
+    TEST_CHECK(copy.capacity() == 10 && copy[9] == 42 && adjacency[13].size() == 6);
+
+    // 255 slots fit uint8_t, the growth after them doesn't
+    Vector<int, CompactAllocator<int, uint8_t> > tiny;
+    for (int i = 0; i < 255; ++i)
+        tiny.pushBack(i);
+
+    TEST_CHECK(tiny.size() == 255 && tiny.back() == 254);
+    TEST_CHECK_THROWS(tiny.pushBack(255), StdErrors::MemAllocErr);
+    TEST_CHECK(tiny.tryReserve(256) == StdErrors::MemAllocErr && tiny.size() == 255);
+
+    // Growth from 201 would ask for 403, it is capped at the 255 slots that still fit
+    Vector<int, CompactAllocator<int, uint8_t> > capped;
+    capped.reserve(100);
+    for (int i = 0; i < 255; ++i)
+        capped.pushBack(i);
+
+    TEST_CHECK(capped.size() == 255 && capped.capacity() == 255 && capped.back() == 254);
+    TEST_CHECK(capped.tryPushBack(255) == StdErrors::MemAllocErr && capped.size() == 255);
+
+    Vector<int, CompactAllocator<int, uint8_t> > cappedTry;
+    cappedTry.reserve(100);
+    bool allPushed = true;
+    for (int i = 0; i < 255; ++i)
+        allPushed = allPushed && cappedTry.tryPushBack(i) == StdErrors::Ok;
+
+    TEST_CHECK(allPushed && cappedTry.capacity() == 255);
+}
+
+TEST_CASE(deferredReleaseFreesLargeBuffersInBackground)
+{
+    using DeferredVector = Vector<int64_t, DynamicAllocator<int64_t, DeferredRelease<4096> > >;
+
+    BufferReclaimer& reclaimer = BufferReclaimer::defaultReclaimer();
+    reclaimer.flush();
+
+    size_t reclaimedBefore = reclaimer.reclaimedCount();
+
+    {
+        DeferredVector small(10, 1);
+        DeferredVector large(100000, 2);
+
+        // Growth hands the old large buffer over as well
+        large.pushBack(3);
+        TEST_CHECK(large.size() == 100001 && large[0] == 2 && large.back() == 3 && small[9] == 1);
+    }
+
+    reclaimer.flush();
+    TEST_CHECK(reclaimer.reclaimedCount() == reclaimedBefore + 2);
+}
+
+TEST_CASE(bufferReclaimerDrainsBoundedQueue)
+{
+    {
+        BufferReclaimer reclaimer{2};
+        TEST_CHECK(reclaimer.queueDepth() == 2);
+
+        // Whatever doesn't fit the queue is freed right away, nothing leaks either way
+        for (int i = 0; i < 100; ++i)
+            reclaimer.retire(new char[1 << 16]);
+
+        reclaimer.retire(nullptr);
+        reclaimer.flush();
+
+        size_t reclaimed = reclaimer.reclaimedCount();
+        TEST_CHECK(reclaimed >= 1 && reclaimed <= 100);
+
+        // Still queued when the reclaimer goes away, its destructor frees it
+        reclaimer.retire(new char[16]);
+    }
+}
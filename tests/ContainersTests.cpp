@@ -0,0 +1,604 @@
+#include "Tests.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.hpp"
+#include "Allocators/StaticAllocator.hpp"
+#include "Containers/SegmentedVector.hpp"
+#include "Containers/IncrementalVector.hpp"
+#include "Containers/PersistentVector.hpp"
+#include "Containers/SoaVector.hpp"
+#include "Containers/FlatMap.hpp"
+#include "Containers/FlatSet.hpp"
+#include "Containers/HashMap.hpp"
+#include "Containers/JaggedVector.hpp"
+#include "Containers/ShardedVector.hpp"
+#include "Containers/PackedIntVector.hpp"
+#include "Parallel/ThreadPool.hpp"
+
+using namespace MyStd;
+
+TEST_CASE(segmentedVectorKeepsReferencesStable)
+{
+    SegmentedVector<int> vector;
+
+    vector.pushBack(0);
+    const int* first = &vector[0];
+
+    for (int i = 1; i < 10000; ++i)
+        vector.pushBack(i);
+
+    bool allMatch = true;
+    for (size_t i = 0; i < vector.size(); ++i)
+        allMatch = allMatch && vector[i] == int(i);
+
+    TEST_CHECK(allMatch);
+    TEST_CHECK(first == &vector[0] && vector.front() == 0 && vector.back() == 9999);
+
+    size_t visited = 0;
+    vector.forEachSegment([&](const int* data, size_t count)
+    {
+        allMatch = allMatch && data[0] == int(visited);
+        visited += count;
+    });
+
+    TEST_CHECK(allMatch && visited == vector.size());
+
+    int64_t sum = 0;
+    for (int value : vector)
+        sum += value;
+
+    TEST_CHECK(sum == int64_t(9999) * 10000 / 2);
+    TEST_CHECK_THROWS(vector.at(10000), StdErrors::VectorIndexOutOfBounds);
+}
+
+TEST_CASE(segmentedVectorShrinksAndCopies)
+{
+    SegmentedVector<int, FixedSegments<4>, StaticAllocator<int, 16> > vector;
+
+    for (int i = 0; i < 100; ++i)
+        vector.pushBack(i);
+
+    TEST_CHECK(vector.segmentsCount() == 7 && vector.segmentSize(6) == 4);
+
+    SegmentedVector<int, FixedSegments<4>, StaticAllocator<int, 16> > copy{vector};
+
+    while (vector.size() > 20)
+        vector.popBack();
+
+    vector.shrinkToFit();
+
+    TEST_CHECK(vector.segmentsCount() == 2 && vector.capacity() == 32);
+    TEST_CHECK(copy.size() == 100 && copy[99] == 99 && vector.back() == 19);
+
+    vector.clear();
+    TEST_CHECK(vector.empty());
+}
+
+TEST_CASE(incrementalVectorReadsBothBuffersWhileMigrating)
+{
+    IncrementalVector<int> vector;
+
+    bool sawMigration = false;
+    bool allMatch = true;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        vector.pushBack(i);
+        sawMigration = sawMigration || vector.isMigrating();
+
+        if (vector.isMigrating())
+        {
+            for (size_t pos = 0; pos < vector.size(); ++pos)
+                allMatch = allMatch && vector[pos] == int(pos);
+        }
+    }
+
+    TEST_CHECK(sawMigration && allMatch);
+
+    // Pops reach into the old buffer when nothing was pushed after the growth
+    while (!vector.isMigrating())
+        vector.pushBack(int(vector.size()));
+
+    size_t sizeBefore = vector.size();
+    vector.popBack();
+    vector.popBack();
+
+    TEST_CHECK(vector.size() == sizeBefore - 2 && vector.back() == int(sizeBefore - 3));
+
+    vector.finishMigration();
+    TEST_CHECK(!vector.isMigrating() && vector.at(100) == 100);
+    TEST_CHECK_THROWS(vector.at(vector.size()), StdErrors::VectorIndexOutOfBounds);
+}
+
+TEST_CASE(incrementalVectorMovesMidMigration)
+{
+    IncrementalVector<int> vector;
+
+    while (!vector.isMigrating() || vector.size() < 64)
+        vector.pushBack(int(vector.size()));
+
+    size_t size = vector.size();
+    IncrementalVector<int> moved{std::move(vector)};
+
+    TEST_CHECK(vector.empty() && moved.size() == size && moved.isMigrating());
+
+    IncrementalVector<int> assigned;
+    assigned.pushBack(-1);
+    assigned = std::move(moved);
+
+    int64_t sum = 0;
+    for (int value : assigned)
+        sum += value;
+
+    TEST_CHECK(assigned.size() == size && sum == int64_t(size) * int64_t(size - 1) / 2);
+}
+
+TEST_CASE(persistentVectorKeepsOldVersions)
+{
+    // Enough elements for a root above two trie levels
+    const size_t size = 2000;
+
+    PersistentVector<int> empty;
+    PersistentVector<int> full = empty;
+    for (size_t i = 0; i < size; ++i)
+        full = full.pushBack(int(i));
+
+    PersistentVector<int> changed = full.set(5, -5).set(size - 1, -1);
+    PersistentVector<int> shorter = full;
+    for (size_t i = 0; i < 1000; ++i)
+        shorter = shorter.popBack();
+
+    TEST_CHECK(empty.empty() && full.size() == size && shorter.size() == size - 1000);
+    TEST_CHECK(full[5] == 5 && full.back() == int(size - 1));
+    TEST_CHECK(changed[5] == -5 && changed.back() == -1 && changed[6] == 6);
+    TEST_CHECK(shorter.back() == 999 && shorter.front() == 0);
+    TEST_CHECK_THROWS(shorter.at(1000), StdErrors::VectorIndexOutOfBounds);
+
+    Vector<int> flat = full.toVector();
+    bool allMatch = flat.size() == size;
+    for (size_t i = 0; allMatch && i < size; ++i)
+        allMatch = flat[i] == int(i);
+
+    TEST_CHECK(allMatch);
+
+    PersistentVector<int> rebuilt{flat};
+    size_t visited = 0;
+    rebuilt.forEachLeaf([&](const int* data, size_t count)
+    {
+        allMatch = allMatch && data[0] == int(visited);
+        visited += count;
+    });
+
+    TEST_CHECK(allMatch && visited == size);
+}
+
+namespace
+{
+
+// Counts live objects, the copy that brings copiesLeft to zero throws
+struct CountedValue
+{
+    static inline int alive      = 0;
+    static inline int copiesLeft = -1;
+
+    int value;
+
+    CountedValue(int initValue) : value(initValue) { ++alive; }
+
+    CountedValue(const CountedValue& other) : value(other.value)
+    {
+        if (copiesLeft > 0 && --copiesLeft == 0)
+        {
+            throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                StdErrors::VectorCtorErr, "Copy failed on purpose", {}
+            );
+        }
+
+        ++alive;
+    }
+
+    CountedValue& operator=(const CountedValue& other) = default;
+
+    ~CountedValue() { --alive; }
+};
+
+} // namespace anon
+
+TEST_CASE(persistentVectorCleansUpFailedLeafCopy)
+{
+    {
+        PersistentVector<CountedValue> vector;
+        for (int i = 0; i < 10; ++i)
+            vector = vector.pushBack(CountedValue{i});
+
+        int aliveBefore = CountedValue::alive;
+
+        // set copies the whole tail leaf, the fourth element copy fails
+        CountedValue::copiesLeft = 4;
+        TEST_CHECK_THROWS(vector.set(9, CountedValue{-1}), StdErrors::VectorCtorErr);
+        CountedValue::copiesLeft = -1;
+
+        TEST_CHECK(CountedValue::alive == aliveBefore && vector[9].value == 9);
+    }
+
+    TEST_CHECK(CountedValue::alive == 0);
+}
+
+TEST_CASE(soaVectorKeepsColumnsInStep)
+{
+    SoaVector<int, double, char> vector;
+
+    for (int i = 0; i < 300; ++i)
+        vector.pushBack(i, double(i) / 4, char('a' + i % 26));
+
+    vector.emplaceBack(-1, 0.25, 'z');
+
+    TEST_CHECK(vector.size() == 301 && vector.capacity() >= 301);
+    TEST_CHECK(uintptr_t(vector.column<1>()) % cacheLineSize == 0);
+    TEST_CHECK(vector[27].get<2>() == 'b' && vector.at(300).get<0>() == -1);
+    TEST_CHECK(int(vector.get<1>(10) * 4) == 10);
+    TEST_CHECK_THROWS(vector.at(301), StdErrors::VectorIndexOutOfBounds);
+
+    vector.popBack();
+    TEST_CHECK(vector.size() == 300 && vector[299].get<0>() == 299);
+}
+
+TEST_CASE(soaVectorMovesWithoutCopying)
+{
+    static_assert(std::is_nothrow_move_constructible<SoaVector<int, double> >::value,
+                  "aligned columns move in O(1)");
+
+    SoaVector<int, double> vector;
+    for (int i = 0; i < 100; ++i)
+        vector.pushBack(i, double(i));
+
+    const int* column = vector.column<0>();
+
+    SoaVector<int, double> moved{std::move(vector)};
+    TEST_CHECK(vector.empty() && moved.size() == 100 && moved.column<0>() == column);
+
+    SoaVector<int, double> assigned;
+    assigned.pushBack(1, 1.0);
+    assigned = std::move(moved);
+    TEST_CHECK(assigned.size() == 100 && assigned.column<0>() == column && assigned[99].get<0>() == 99);
+
+    BasicSoaVector<StaticColumns<8>, int, int> inline1;
+    BasicSoaVector<StaticColumns<8>, int, int> inline2;
+    inline1.pushBack(1, 2);
+    inline1.swap(inline2);
+    TEST_CHECK(inline1.empty() && inline2.size() == 1 && inline2[0].get<1>() == 2);
+}
+
+namespace
+{
+
+// Counts buffers handed back by DynamicAllocator
+struct CountingRelease
+{
+    static inline size_t releasedBuffers = 0;
+
+    static void release(char* buffer, size_t) noexcept
+    {
+        releasedBuffers += buffer != nullptr;
+        delete [] buffer;
+    }
+};
+
+struct CountingColumns
+{
+    template<typename Field>
+    using Allocator = DynamicAllocator<Field, CountingRelease>;
+};
+
+} // namespace anon
+
+TEST_CASE(soaVectorGrowsEachColumnOnce)
+{
+    BasicSoaVector<CountingColumns, int, double> vector;
+    vector.reserve(4);
+    vector.pushBack(1, 1.0);
+
+    // Only the two old columns are given back, no temporary column is built and copied
+    size_t released = CountingRelease::releasedBuffers;
+    vector.reserve(64);
+    TEST_CHECK(CountingRelease::releasedBuffers - released == 2);
+    TEST_CHECK(vector.capacity() == 64 && vector.get<0>(0) == 1 && int(vector.get<1>(0)) == 1);
+}
+
+TEST_CASE(soaVectorPushesArgumentsAliasingItself)
+{
+    BasicSoaVector<DynamicColumns, int, Vector<int> > vector;
+    vector.pushBack(7, Vector<int>(3, 9));
+
+    // Capacity goes 1, 3, 7, 15: three of these pushes copy a row from storage their growth frees
+    size_t grown = 0;
+    for (size_t i = 0; i < 7; ++i)
+    {
+        grown += vector.size() == vector.capacity();
+        vector.pushBack(vector.get<0>(0), vector.get<1>(0));
+    }
+
+    bool same = true;
+    for (size_t row = 0; row < vector.size(); ++row)
+        same = same && vector.get<0>(row) == 7 && vector.get<1>(row).size() == 3 && vector.get<1>(row)[2] == 9;
+
+    TEST_CHECK(grown == 3 && vector.size() == 8 && same);
+}
+
+TEST_CASE(flatMapInsertsArgumentsAliasingItself)
+{
+    FlatMap<int, int> map;
+
+    for (int key = 1; key < 10; key += 2)
+        map.insert(key, key * 10);
+
+    // valueAt(3) is 70 and sits right where the shift moves elements
+    map.insert(2, map.valueAt(3));
+    TEST_CHECK(map.size() == 6 && map.at(2) == 70 && map.at(7) == 70 && map.at(9) == 90);
+
+    // Key taken from the value column of a map whose columns are both full
+    FlatMap<int, int> same;
+    for (int key = 0; key < 16; ++key)
+        same.insert(key * 100, key);
+
+    same.insertOrAssign(same.valueAt(15), same.keyAt(1));
+    TEST_CHECK(same.at(15) == 100 && same.size() == 17 && same.keyAt(1) == 15);
+
+    TEST_CHECK(map.insertOrAssign(2, map.valueAt(0)) == false && map.at(2) == 10);
+    TEST_CHECK_THROWS(map.at(4), StdErrors::KeyNotFound);
+}
+
+TEST_CASE(flatSetKeepsKeysSortedAndUnique)
+{
+    FlatSet<int> set;
+
+    for (int key = 20; key > 0; key -= 2)
+        set.insert(key);
+
+    TEST_CHECK(!set.insert(set[5]) && set.size() == 10);
+    TEST_CHECK(set.erase(4) && !set.erase(4) && !set.contains(4));
+
+    Vector<int> batch(3, 0);
+    batch[0] = 7;
+    batch[1] = 3;
+    batch[2] = 8;
+    set.insertBulk(batch);
+
+    bool sorted = true;
+    for (size_t i = 1; i < set.size(); ++i)
+        sorted = sorted && set[i - 1] < set[i];
+
+    TEST_CHECK(sorted && set.size() == 11 && set.contains(7) && set.find(5) == set.size());
+}
+
+TEST_CASE(hashMapSurvivesRehashesAndTombstones)
+{
+    HashMap<int64_t, int64_t> map;
+
+    for (int64_t key = 0; key < 5000; ++key)
+        map.insert(key * 7, key);
+
+    for (int64_t key = 0; key < 5000; key += 2)
+        map.erase(key * 7);
+
+    // Churn on tombstones must not grow the table forever
+    size_t capacity = map.capacity();
+    for (int64_t round = 0; round < 20000; ++round)
+    {
+        map.insert(-round - 1, round);
+        map.erase(-round - 1);
+    }
+
+    TEST_CHECK(map.size() == 2500 && map.capacity() == capacity);
+    TEST_CHECK(map.at(7) == 1 && !map.contains(14) && map.find(21) && *map.find(21) == 3);
+    TEST_CHECK_THROWS(map.at(14), StdErrors::KeyNotFound);
+
+    int64_t sum = 0;
+    map.forEach([&](const int64_t&, int64_t& value) { sum += value; });
+    TEST_CHECK(sum == 2500 * 2500);
+}
+
+TEST_CASE(hashMapInsertsArgumentsAliasingItself)
+{
+    HashMap<int, int> map;
+
+    // Every insert right at the load factor limit rehashes, arguments point into the old columns
+    bool allMatch = true;
+    map.insert(1, 1);
+
+    for (int key = 2; key < 3000; ++key)
+    {
+        const int& previous = *map.find(key - 1);
+        map.insert(key, previous);
+        map[key] += 1;
+
+        allMatch = allMatch && map.at(key) == key;
+    }
+
+    TEST_CHECK(allMatch);
+
+    HashMap<int, int> same;
+    for (int key = 0; key < 12; ++key)
+        same.insert(key, key + 100);
+
+    same.insertOrAssign(*same.find(11), *same.find(11));
+    TEST_CHECK(same.at(111) == 111 && same.size() == 13);
+}
+
+TEST_CASE(jaggedVectorStoresRowsBackToBack)
+{
+    Vector<Vector<int> > nested(50, Vector<int>{});
+    for (size_t rowId = 0; rowId < nested.size(); ++rowId)
+    {
+        for (size_t i = 0; i < rowId % 5; ++i)
+            nested[rowId].pushBack(int(rowId * 10 + i));
+    }
+
+    JaggedVector<int> jagged{nested};
+    TEST_CHECK(jagged.rowsCount() == 50 && jagged.valuesCount() == 100 && jagged.rowSize(0) == 0);
+    TEST_CHECK(jagged.row(13).size() == 3 && jagged.row(13)[2] == 132 && jagged.offsets()[50] == 100);
+
+    // Row copied out of the container itself, across a reallocation
+    jagged.appendRow(jagged.row(49));
+    jagged.appendRow(VectorView<const int>{});
+    jagged.appendToLastRow(-1);
+
+    TEST_CHECK(jagged.rowsCount() == 52 && jagged.at(50)[3] == 493 && jagged.at(51)[0] == -1);
+    TEST_CHECK(jagged.row(51).data() == jagged.values().data() + 104);
+    TEST_CHECK_THROWS(jagged.at(52), StdErrors::VectorIndexOutOfBounds);
+
+    jagged.clear();
+    TEST_CHECK(jagged.empty() && jagged.valuesCount() == 0);
+}
+
+TEST_CASE(jaggedVectorVisitsEveryRowInParallel)
+{
+    ThreadPool pool{3};
+
+    // One huge row among many short and empty ones, chunk boundaries fall inside it
+    JaggedVector<int64_t> jagged;
+    for (int64_t rowId = 0; rowId < 5000; ++rowId)
+    {
+        jagged.appendRow(VectorView<const int64_t>{});
+        for (int64_t i = 0; i < (rowId == 2000 ? 100000 : rowId % 3); ++i)
+            jagged.appendToLastRow(rowId);
+    }
+
+    jagged.appendRow(VectorView<const int64_t>{});
+
+    Vector<int> visits(jagged.rowsCount(), 0);
+    std::atomic<bool> rowsMatch{true};
+
+    parallelForEachRow(jagged, [&](size_t rowId, VectorView<int64_t> row)
+    {
+        visits[rowId] += 1;
+
+        for (size_t pos = 0; pos < row.size(); ++pos)
+        {
+            if (row[pos] != int64_t(rowId))
+                rowsMatch = false;
+
+            row[pos] *= 2;
+        }
+    }, pool);
+
+    bool allOnce = true;
+    for (size_t rowId = 0; rowId < visits.size(); ++rowId)
+        allOnce = allOnce && visits[rowId] == 1;
+
+    TEST_CHECK(allOnce && rowsMatch.load() && jagged.row(2000)[99999] == 4000);
+}
+
+TEST_CASE(shardedVectorGathersProducerShards)
+{
+    ThreadPool pool{3};
+
+    const size_t chunksCount = 16;
+    ShardedVector<int64_t> sharded{chunksCount};
+
+    // Every chunk owns its shard, no two threads touch the same one
+    pool.parallelFor(chunksCount, [&](size_t chunkId)
+    {
+        for (int64_t i = 0; i < (chunkId == 3 ? 0 : 1000); ++i)
+            sharded.pushBack(chunkId, int64_t(chunkId) * 1000 + i);
+    });
+
+    TEST_CHECK(sharded.size() == 15000 && sharded.shard(3).empty());
+
+    int64_t expected = 0;
+    bool inOrder = true;
+    for (int64_t value : sharded)
+    {
+        expected += expected == 3000 ? 1000 : 0;
+        inOrder = inOrder && value == expected++;
+    }
+
+    TEST_CHECK(inOrder && expected == 16000);
+
+    Vector<int64_t> merged(1, -1);
+    sharded.appendTo(merged);
+    TEST_CHECK(merged.size() == 15001 && merged[0] == -1 && merged[3001] == 4000 && merged[15000] == 15999);
+
+    sharded.clear();
+    TEST_CHECK(sharded.empty() && sharded.begin() == sharded.end());
+}
+
+TEST_CASE(shardedVectorConcatenatesNonTrivialElements)
+{
+    ShardedVector<Vector<int> > sharded{3};
+
+    sharded.pushBack(2, Vector<int>(2, 7));
+    sharded.pushBack(0, Vector<int>(1, 5));
+
+    Vector<Vector<int> > merged = sharded.concatenate();
+    TEST_CHECK(merged.size() == 2 && merged[0][0] == 5 && merged[1].size() == 2 && merged[1][1] == 7);
+
+    TEST_CHECK_THROWS(ShardedVector<int>{0}, StdErrors::VectorCtorErr);
+}
+
+TEST_CASE(packedIntVectorStoresValuesAcrossWords)
+{
+    // 7 bits don't divide 64, so values keep straddling word boundaries
+    PackedIntVector<7> packed;
+    for (uint32_t i = 0; i < 1000; ++i)
+        packed.pushBack(i * 37 % 128);
+
+    TEST_CHECK(packed.size() == 1000 && packed.words().size() == (1000 * 7 + 63) / 64);
+
+    bool same = true;
+    for (uint32_t i = 0; i < 1000; ++i)
+        same = same && packed[i] == i * 37 % 128;
+
+    TEST_CHECK(same);
+
+    // Neighbours of a straddling value stay untouched, extra bits are dropped
+    packed.set(9, 0xFFFFFFFF);
+    TEST_CHECK(packed[9] == 127 && packed[8] == 8 * 37 % 128 && packed[10] == 10 * 37 % 128);
+
+    packed.popBack();
+    packed.resize(1001);
+    TEST_CHECK(packed[999] == 0 && packed[1000] == 0);
+
+    TEST_CHECK_THROWS(packed.at(1001), StdErrors::VectorIndexOutOfBounds);
+}
+
+TEST_CASE(packedIntVectorPacksAndUnpacksEveryWidth)
+{
+    Vector<uint32_t> values(501, 0);
+
+    for (unsigned bits = 1; bits <= 32; ++bits)
+    {
+        DynamicPackedIntVector packed{bits};
+
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = uint32_t(i * 2654435761u) & packed.maxValue();
+
+        packed.pack(VectorView<const uint32_t>{values});
+
+        Vector<uint32_t> unpacked;
+        packed.unpack(unpacked);
+
+        bool same = unpacked.size() == values.size();
+        for (size_t i = 0; same && i < values.size(); ++i)
+            same = unpacked[i] == values[i] && packed.get(i) == values[i];
+
+        Vector<uint32_t> middle(100, 0);
+        packed.unpack(333, VectorView<uint32_t>{middle});
+        same = same && middle[0] == values[333] && middle[99] == values[432];
+
+        TEST_CHECK(same);
+    }
+
+    PackedIntVector<20> packed;
+    packed.resize(3);
+
+    Vector<uint32_t> tooLong(2, 0);
+    TEST_CHECK_THROWS(packed.unpack(2, VectorView<uint32_t>{tooLong}), StdErrors::VectorIndexOutOfBounds);
+
+    TEST_CHECK_THROWS(DynamicPackedIntVector{33}, StdErrors::VectorCtorErr);
+    TEST_CHECK_THROWS(DynamicPackedIntVector{0}, StdErrors::VectorCtorErr);
+}
@@ -0,0 +1,70 @@
+#include "Tests.hpp"
+
+#include <cstring>
+#include <thread>
+#include <utility>
+
+using namespace MyStd;
+
+namespace
+{
+
+ExceptionWithReason makeChain(size_t length)
+{
+    ExceptionWithReason exception = EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(StdErrors::MemAllocErr, "root", {});
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        exception = EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+            StdErrors::VectorCtorErr, "wrapper", std::move(exception)
+        );
+    }
+
+    return exception;
+}
+
+} // namespace anon
+
+TEST_CASE(exceptionChainKeepsNewestAndRootFrames)
+{
+    ExceptionWithReason shortChain = makeChain(3);
+    TEST_CHECK(shortChain.chainLength() == 3 && shortChain.error() == StdErrors::VectorCtorErr);
+    TEST_CHECK(shortChain.frame(2).error == StdErrors::MemAllocErr);
+
+    ExceptionWithReason longChain = makeChain(20);
+    const size_t kept = ExceptionWithReason::maxChainLength;
+
+    TEST_CHECK(longChain.chainLength() == kept);
+    TEST_CHECK(strcmp(longChain.frame(kept - 1).reason, "root") == 0);
+    TEST_CHECK(strstr(longChain.what(), "... 12 more") != nullptr);
+    TEST_CHECK(strstr(longChain.what(), "19. root") != nullptr);
+}
+
+TEST_CASE(exceptionWhatIsFormattedOnceAcrossThreads)
+{
+    ExceptionWithReason exception = makeChain(5);
+
+    const char* seen[4] = {};
+    {
+        std::thread first {[&]() { seen[0] = exception.what(); }};
+        std::thread second{[&]() { seen[1] = exception.what(); }};
+        std::thread third {[&]() { seen[2] = exception.what(); }};
+        seen[3] = exception.what();
+
+        first.join();
+        second.join();
+        third.join();
+    }
+
+    TEST_CHECK(seen[0] == seen[1] && seen[1] == seen[2] && seen[2] == seen[3]);
+
+    // Formatted text moves with the exception
+    ExceptionWithReason moved{std::move(exception)};
+    TEST_CHECK(moved.what() == seen[0]);
+
+    ExceptionWithReason assigned;
+    TEST_CHECK(assigned.error() == StdErrors::Ok);
+
+    assigned = std::move(moved);
+    TEST_CHECK(assigned.what() == seen[0] && assigned.error() == StdErrors::VectorCtorErr);
+}
@@ -0,0 +1,77 @@
+// Compiled with -fno-exceptions by "make noexceptions", never linked. Explicit instantiation compiles every
+// member, so a throw or try left outside the exception macros fails the build
+
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "Allocators/AlignedAllocator.hpp"
+#include "Allocators/CompactAllocator.hpp"
+#include "Allocators/DynamicAllocator.hpp"
+#include "Allocators/FileMappedAllocator.hpp"
+#include "Allocators/ShrinkingAllocator.hpp"
+#include "Allocators/StaticAllocator.hpp"
+
+namespace MyStd
+{
+
+template class DynamicAllocator<int>;
+template class AlignedAllocator<int>;
+template class StaticAllocator<int, 16>;
+template class CompactAllocator<int, uint32_t>;
+template class FileMappedAllocator<int>;
+template class ShrinkingAllocator<int>;
+
+// Vector members that go through the allocators, explicit instantiation of Vector itself would also pull in
+// the iterator range constructor, which is unfinished
+template<typename Allocator>
+void useVector()
+{
+    Vector<int, Allocator> vector;
+
+    vector.reserve(8);
+    vector.pushBack(1);
+    vector.resize(4, 2);
+    vector.at(0) = vector[1];
+    vector.popBack();
+    vector.shrinkToFit();
+
+    Vector<int, Allocator> copy{vector};
+    copy = vector;
+    copy.swap(vector);
+
+    (void)vector.tryPushBack(3);
+    (void)vector.tryResize(2);
+    (void)vector.tryAt(7);
+}
+
+template void useVector<DynamicAllocator<int> >();
+template void useVector<AlignedAllocator<int> >();
+template void useVector<StaticAllocator<int, 16> >();
+template void useVector<CompactAllocator<int, uint32_t> >();
+template void useVector<ShrinkingAllocator<int> >();
+
+template<typename T>
+void useFileMappedVector()
+{
+    Vector<T, FileMappedAllocator<T> > vector{FileMappedAllocator<T>::open("noexceptions.bin")};
+
+    vector.reserve(8);
+    vector.pushBack(1);
+    vector.resize(4, 2);
+    vector.at(0) = vector[1];
+}
+
+template<typename T>
+void useBoolVector()
+{
+    Vector<T> bits;
+
+    bits.reserve(8);
+    bits.pushBack(true);
+    bits.popBack();
+}
+
+template void useFileMappedVector<int>();
+template void useBoolVector<bool>();
+
+} // namespace MyStd
@@ -0,0 +1,445 @@
+#include "Tests.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Allocators/StaticAllocator.hpp"
+#include "Parallel/ChunkPartition.hpp"
+#include "Parallel/ConcurrentAppender.hpp"
+#include "Parallel/RcuVector.hpp"
+#include "Parallel/ParallelAlgorithms.hpp"
+#include "Parallel/SpscRing.hpp"
+#include "Parallel/ThreadPool.hpp"
+
+using namespace MyStd;
+
+TEST_CASE(threadPoolRunsEveryChunkOnce)
+{
+    ThreadPool pool{4};
+
+    const size_t chunksCount = 1000;
+    Vector<int> hits(chunksCount, 0);
+
+    pool.parallelFor(chunksCount, [&](size_t chunkId) { hits[chunkId] += 1; });
+
+    bool allOnce = true;
+    for (size_t i = 0; i < chunksCount; ++i)
+        allOnce = allOnce && hits[i] == 1;
+
+    TEST_CHECK(allOnce);
+}
+
+TEST_CASE(threadPoolRethrowsFromBody)
+{
+    ThreadPool pool{2};
+
+    TEST_CHECK_THROWS(
+        pool.parallelFor(64, [](size_t chunkId)
+        {
+            if (chunkId == 17)
+            {
+                throw EXCEPTION_WITH_REASON_CREATE_NEXT_EXCEPTION(
+                    StdErrors::VectorIndexOutOfBounds, "test", {}
+                );
+            }
+        }),
+        StdErrors::VectorIndexOutOfBounds
+    );
+}
+
+TEST_CASE(threadPoolNestedParallelFor)
+{
+    ThreadPool pool{2};
+    std::atomic<size_t> total{0};
+
+    pool.parallelFor(8, [&](size_t)
+    {
+        pool.parallelFor(8, [&](size_t) { total.fetch_add(1); });
+    });
+
+    TEST_CHECK(total.load() == 64);
+}
+
+TEST_CASE(threadPoolWithoutThreadsRunsSubmitInline)
+{
+    ThreadPool pool{0};
+    bool ran = false;
+
+    pool.submit([&ran]() { ran = true; });
+
+    TEST_CHECK(ran);
+}
+
+TEST_CASE(threadPoolSubmitFromManyThreads)
+{
+    std::atomic<size_t> done{0};
+
+    {
+        ThreadPool pool{3};
+        pool.parallelFor(16, [&](size_t)
+        {
+            for (int i = 0; i < 100; ++i)
+                pool.submit([&done]() { done.fetch_add(1); });
+        });
+    }
+
+    TEST_CHECK(done.load() == 1600);
+}
+
+TEST_CASE(parallelAlgorithmsOverVectorAndView)
+{
+    ThreadPool pool{3};
+
+    const size_t size = 100003;
+    Vector<int64_t> vector(size, 1);
+
+    parallelTransform(vector, [](int64_t value) { return value * 3; }, pool);
+    TEST_CHECK(parallelReduce(vector, int64_t(0), [](int64_t lhs, int64_t rhs) { return lhs + rhs; }, pool)
+               == int64_t(3 * size));
+
+    VectorView<int64_t> middle = VectorView<int64_t>{vector}.subview(10, 100);
+    parallelFill(middle, int64_t(0), pool);
+    TEST_CHECK(vector[9] == 3 && vector[10] == 0 && vector[109] == 0 && vector[110] == 3);
+
+    Vector<double> halves;
+    parallelTransform(vector, halves, [](int64_t value) { return double(value) / 2; }, pool);
+    TEST_CHECK(halves.size() == size && int64_t(halves[0] * 2) == 3);
+}
+
+TEST_CASE(parallelBitAlgorithmsOnSubview)
+{
+    ThreadPool pool{3};
+
+    const size_t size = 200000;
+    Vector<bool> bits(size, false);
+
+    BitView tail = BitView{bits}.subview(3);
+    parallelFill(tail, true, pool);
+
+    auto sum = [](size_t lhs, size_t rhs) { return lhs + rhs; };
+
+    size_t ones = parallelReduce(bits, size_t(0), sum, pool);
+    TEST_CHECK(ones == size - 3);
+    TEST_CHECK(!bits[2] && bits[3]);
+
+    parallelTransform(tail, [](bool bit) { return !bit; }, pool);
+    ones = parallelReduce(bits, size_t(0), sum, pool);
+    TEST_CHECK(ones == 0);
+}
+
+TEST_CASE(bitChunksStartOnAlignedWords)
+{
+    ThreadPool pool{3};
+
+    Vector<bool> bits(300000, false);
+
+    // Starts 3 bytes and 5 bits into the storage, neither byte nor word aligned
+    BitView view = BitView{bits}.subview(29);
+    ChunkPartition partition = makeBitsPartition(view.data(), view.size(), view.bitOffset(), pool);
+
+    const uintptr_t firstBit = reinterpret_cast<uintptr_t>(view.data()) * __CHAR_BIT__ + view.bitOffset();
+
+    bool allAligned = partition.chunksCount() > 1;
+    for (size_t chunkId = 1; chunkId < partition.chunksCount(); ++chunkId)
+        allAligned = allAligned && (firstBit + partition.begin(chunkId)) % 64 == 0;
+
+    TEST_CHECK(allAligned);
+
+    parallelFill(view, true, pool);
+    parallelTransform(view.subview(1), [](bool bit) { return !bit; }, pool);
+
+    TEST_CHECK(!bits[28] && bits[29] && !bits[30] && !bits[bits.size() - 1]);
+}
+
+TEST_CASE(parallelResizeFillsNewElements)
+{
+    ThreadPool pool{3};
+
+    Vector<int64_t> vector(5, 1);
+    vector[4] = 9;
+
+    // Fill value is one of the elements the growth moves away
+    parallelResize(vector, 300001, vector[4], pool);
+
+    int64_t sum = parallelReduce(vector, int64_t(0), [](int64_t lhs, int64_t rhs) { return lhs + rhs; }, pool);
+    TEST_CHECK(vector.size() == 300001 && vector[3] == 1 && vector[300000] == 9);
+    TEST_CHECK(sum == 4 + int64_t(300001 - 4) * 9);
+
+    parallelResize(vector, 2, int64_t(0), pool);
+    TEST_CHECK(vector.size() == 2 && vector[1] == 1);
+
+    Vector<double> halves = parallelConstruct(100000, 0.5, pool);
+    TEST_CHECK(halves.size() == 100000 && int64_t(halves[99999] * 2) == 1);
+
+    auto count = [](size_t lhs, size_t rhs) { return lhs + rhs; };
+
+    Vector<bool> bits(3, true);
+    parallelResize(bits, 200003, false, pool);
+    TEST_CHECK(bits[2] && !bits[3] && parallelReduce(bits, size_t(0), count, pool) == 3);
+
+    parallelResize(bits, 2, true, pool);
+    TEST_CHECK(bits.size() == 2 && bits[1]);
+}
+
+TEST_CASE(concurrentAppenderPublishesContiguousPrefix)
+{
+    ThreadPool pool{3};
+
+    Vector<uint64_t> vector(10, 0);
+    const size_t maxCount = 200000;
+
+    std::atomic<bool> prefixValid{true};
+
+    {
+        ConcurrentAppender<uint64_t> appender{vector, maxCount};
+
+        // Slot i holds i, so a reader can check the prefix it sees was really written
+        std::thread reader{[&appender, &prefixValid, maxCount]()
+        {
+            for (size_t seen = 10; seen < maxCount; seen += 997)
+            {
+                appender.waitForCommitted(seen);
+                prefixValid = prefixValid && appender.data()[seen - 1] == (seen - 1 < 10 ? 0 : seen - 1);
+            }
+        }};
+
+        pool.parallelFor(64, [&appender](size_t chunkId)
+        {
+            while (true)
+            {
+                size_t count = 1 + chunkId % 13;
+                size_t begin = appender.claim(count);
+
+                if (begin == ConcurrentAppender<uint64_t>::noRoom)
+                    return;
+
+                for (size_t i = begin; i < begin + count; ++i)
+                    appender.data()[i] = i;
+
+                appender.publish(begin, count);
+            }
+        });
+
+        reader.join();
+
+        TEST_CHECK(appender.committed() <= maxCount + 10 && appender.claim(1) == ConcurrentAppender<uint64_t>::noRoom);
+    }
+
+    bool allMatch = vector.size() > maxCount + 10 - 13 && vector.capacity() == maxCount + 10;
+    for (size_t i = 10; allMatch && i < vector.size(); ++i)
+        allMatch = vector[i] == i;
+
+    TEST_CHECK(prefixValid.load() && allMatch && vector[9] == 0);
+}
+
+TEST_CASE(concurrentAppenderFinishesOnce)
+{
+    Vector<int> vector;
+
+    {
+        ConcurrentAppender<int> appender{vector, 4};
+
+        size_t begin = appender.claim(2);
+        appender.data()[begin]     = 1;
+        appender.data()[begin + 1] = 2;
+        appender.publish(begin, 2);
+
+        // Vector belongs to the caller after finish, the destructor leaves it alone
+        appender.finish();
+        vector.pushBack(3);
+        appender.finish();
+    }
+
+    TEST_CHECK(vector.size() == 3 && vector[0] == 1 && vector[2] == 3);
+
+    {
+        ConcurrentAppender<int> appender{vector, 4};
+        appender.publish(appender.claim(1), 1);
+
+        appender.finish();
+        vector.clear();
+    }
+
+    TEST_CHECK(vector.empty());
+}
+
+TEST_CASE(rcuVectorReadersSeeConsistentPrefixes)
+{
+    const size_t readersCount = 4;
+    const uint64_t count = 200000;
+
+    RcuVector<uint64_t> vector{readersCount};
+    std::atomic<bool> writerDone{false};
+    std::atomic<bool> allValid{true};
+
+    std::thread readers[readersCount];
+    for (size_t readerId = 0; readerId < readersCount; ++readerId)
+    {
+        readers[readerId] = std::thread{[&vector, &writerDone, &allValid, readerId]()
+        {
+            size_t lastSize = 0;
+
+            while (!writerDone.load())
+            {
+                RcuVector<uint64_t>::ReadGuard guard = vector.read(readerId);
+
+                // Element i holds i, check both ends and a few in the middle of what the guard sees
+                bool valid = guard.size() >= lastSize;
+                for (size_t pos = guard.size(); pos > 0 && guard.size() - pos < 64; --pos)
+                    valid = valid && guard[pos - 1] == pos - 1;
+
+                if (guard.size() != 0)
+                    valid = valid && guard[0] == 0 && guard[guard.size() / 2] == guard.size() / 2;
+
+                allValid = allValid && valid;
+                lastSize = guard.size();
+
+                std::this_thread::yield();
+            }
+        }};
+    }
+
+    for (uint64_t value = 0; value < count; ++value)
+        vector.pushBack(value);
+
+    writerDone = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    TEST_CHECK(allValid.load() && vector.size() == count);
+
+    // Nobody reads anymore, every old buffer can go
+    TEST_CHECK(vector.reclaim() == 0);
+
+    RcuVector<uint64_t>::ReadGuard guard = vector.read(0);
+    TEST_CHECK(guard.size() == count && guard[count - 1] == count - 1);
+
+    // A pinned reader keeps the buffer it saw alive across growth
+    for (uint64_t value = count; value < 2 * count; ++value)
+        vector.pushBack(value);
+
+    TEST_CHECK(vector.reclaim() >= 1 && guard[count - 1] == count - 1);
+}
+
+namespace
+{
+
+// Producer and consumer switch between single, batch and span operations, values must arrive in order
+template<typename Ring>
+bool passesSequenceThroughRing(Ring& ring, uint64_t count)
+{
+    std::thread producer{[&ring, count]()
+    {
+        uint64_t batch[37] = {};
+        uint64_t next = 0;
+
+        while (next < count)
+        {
+            size_t pushed = 0;
+
+            if (next % 3 == 0)
+            {
+                pushed = ring.tryPush(next);
+            }
+            else if (next % 3 == 1)
+            {
+                size_t batchSize = size_t(std::min<uint64_t>(37, count - next));
+                for (size_t i = 0; i < batchSize; ++i)
+                    batch[i] = next + i;
+
+                pushed = ring.pushBatch(VectorView<const uint64_t>{batch, batchSize});
+            }
+            else
+            {
+                VectorView<uint64_t> span = ring.writableSpan();
+
+                pushed = size_t(std::min<uint64_t>(span.size(), count - next));
+                for (size_t i = 0; i < pushed; ++i)
+                    span[i] = next + i;
+
+                ring.commitWrite(pushed);
+            }
+
+            next += pushed;
+
+            if (pushed == 0)
+                std::this_thread::yield();
+        }
+    }};
+
+    uint64_t out[50] = {};
+    uint64_t expected = 0;
+    bool inOrder = true;
+
+    while (expected < count)
+    {
+        size_t popped = 0;
+        uint64_t value = 0;
+
+        if (expected % 3 == 0)
+        {
+            popped = ring.tryPop(value);
+            inOrder = inOrder && (popped == 0 || value == expected);
+        }
+        else if (expected % 3 == 1)
+        {
+            popped = ring.popBatch(VectorView<uint64_t>{out, 50});
+            for (size_t i = 0; i < popped; ++i)
+                inOrder = inOrder && out[i] == expected + i;
+        }
+        else
+        {
+            VectorView<const uint64_t> span = ring.readableSpan();
+
+            popped = span.size();
+            for (size_t i = 0; i < popped; ++i)
+                inOrder = inOrder && span[i] == expected + i;
+
+            ring.commitRead(popped);
+        }
+
+        expected += popped;
+
+        if (popped == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    return inOrder && ring.empty();
+}
+
+} // namespace anon
+
+TEST_CASE(spscRingPassesValuesInOrder)
+{
+    SpscRing<uint64_t> dynamicRing{1000};
+    TEST_CHECK(dynamicRing.capacity() == 1024);
+    TEST_CHECK(passesSequenceThroughRing(dynamicRing, 300000));
+
+    SpscRing<uint64_t, StaticAllocator<uint64_t, 64> > inlineRing{64};
+    TEST_CHECK(inlineRing.capacity() == 64);
+    TEST_CHECK(passesSequenceThroughRing(inlineRing, 300000));
+}
+
+TEST_CASE(spscRingStopsWhenFull)
+{
+    SpscRing<int, StaticAllocator<int, 8> > ring{5};
+
+    int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    TEST_CHECK(ring.capacity() == 8);
+    TEST_CHECK(ring.pushBatch(VectorView<const int>{values, 10}) == 8 && !ring.tryPush(8));
+
+    int value = -1;
+    TEST_CHECK(ring.tryPop(value) && value == 0 && ring.size() == 7);
+
+    // Free slot is at the wrap point, the span is contiguous and ends there
+    TEST_CHECK(ring.writableSpan().size() == 1 && ring.tryPush(8));
+    TEST_CHECK(ring.readableSpan().size() == 7 && ring.readableSpan()[6] == 7);
+
+    TEST_CHECK_THROWS((SpscRing<int, StaticAllocator<int, 8> >{9}), StdErrors::VectorOnStackNotEnoughMemory);
+}
@@ -0,0 +1,192 @@
+#include "Tests.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <unistd.h>
+
+#include "Vector.hpp"
+#include "Serialization/Snapshot.hpp"
+#include "Serialization/FdIo.hpp"
+
+using namespace MyStd;
+
+namespace
+{
+
+// Unique file in /tmp, removed when the test ends
+class TemporarySnapshotFile final
+{
+    char path_[32];
+
+public:
+    TemporarySnapshotFile() : path_("/tmp/snapshotTestXXXXXX")
+    {
+        int fd = mkstemp(path_);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    TemporarySnapshotFile(const TemporarySnapshotFile& other) = delete;
+    TemporarySnapshotFile& operator=(const TemporarySnapshotFile& other) = delete;
+
+    ~TemporarySnapshotFile() { unlink(path_); }
+
+    const char* path() const noexcept { return path_; }
+};
+
+} // namespace anon
+
+TEST_CASE(snapshotRoundTripsSeveralVectors)
+{
+    TemporarySnapshotFile file;
+
+    Vector<int64_t> numbers(5000, 0);
+    for (size_t i = 0; i < numbers.size(); ++i)
+        numbers[i] = int64_t(i * i);
+
+    Vector<bool> bits(77, false);
+    bits[0]  = true;
+    bits[76] = true;
+
+    {
+        // No explicit flush, the destructor writes the buffered snapshots
+        SnapshotWriter writer{file.path()};
+        writer.write(bits);
+        writer.write(numbers);
+        writer.write(Vector<int64_t>{});
+    }
+
+    SnapshotReader reader{file.path()};
+
+    Vector<bool> loadedBits;
+    Vector<int64_t> loadedNumbers;
+    Vector<int64_t> loadedEmpty(3, 1);
+
+    reader.read(loadedBits);
+    reader.read(loadedNumbers);
+    reader.read(loadedEmpty);
+
+    TEST_CHECK(loadedBits.size() == 77 && loadedBits[0] && loadedBits[76] && !loadedBits[1]);
+    TEST_CHECK(loadedNumbers.size() == 5000 && loadedNumbers[4999] == int64_t(4999) * 4999);
+    TEST_CHECK(loadedEmpty.empty());
+}
+
+TEST_CASE(snapshotRejectsBrokenFiles)
+{
+    TemporarySnapshotFile file;
+
+    Vector<int32_t> numbers(100, 7);
+    saveSnapshot(file.path(), numbers);
+
+    Vector<int64_t> wrongType;
+    TEST_CHECK_THROWS(loadSnapshot(file.path(), wrongType), StdErrors::SnapshotFormatErr);
+
+    // Count promises far more bytes than the file holds, nothing may be allocated for it
+    FILE* stream = fopen(file.path(), "r+b");
+    SnapshotHeader header = {};
+    bool rewritten = stream && fread(&header, sizeof(header), 1, stream) == 1;
+
+    header.count = uint64_t(1) << 60;
+    rewritten = rewritten && fseek(stream, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, stream) == 1;
+
+    if (stream)
+        fclose(stream);
+
+    TEST_CHECK(rewritten);
+
+    Vector<int32_t> loaded;
+    TEST_CHECK_THROWS(loadSnapshot(file.path(), loaded), StdErrors::SnapshotFormatErr);
+
+    // Original count back, one payload byte corrupted
+    header.count = 100;
+    uint8_t garbage = 0xAB;
+
+    stream = fopen(file.path(), "r+b");
+    rewritten = stream && fwrite(&header, sizeof(header), 1, stream) == 1
+                       && fseek(stream, 40, SEEK_SET) == 0 && fwrite(&garbage, 1, 1, stream) == 1;
+
+    if (stream)
+        fclose(stream);
+
+    TEST_CHECK(rewritten);
+    TEST_CHECK_THROWS(loadSnapshot(file.path(), loaded), StdErrors::SnapshotChecksumErr);
+    TEST_CHECK(loaded.empty());
+}
+
+TEST_CASE(fdIoAppendsOnlyWholeElements)
+{
+    int fds[2] = {-1, -1};
+    TEST_CHECK(pipe(fds) == 0);
+
+    Vector<int32_t> sent(10000, 0);
+    for (size_t i = 0; i < sent.size(); ++i)
+        sent[i] = int32_t(i * 31);
+
+    // Pieces of 7 bytes, every read on the other side may stop inside an element
+    std::thread writer{[&sent, fd = fds[1]]()
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(sent.data());
+        size_t total = sent.size() * sizeof(int32_t);
+
+        for (size_t done = 0; done < total; done += 7)
+            writeBytes(fd, bytes + done, std::min<size_t>(7, total - done));
+
+        close(fd);
+    }};
+
+    Vector<int32_t> received;
+    size_t calls = 0;
+    while (appendFromFd(received, fds[0], 1000).count != 0)
+        ++calls;
+
+    writer.join();
+    close(fds[0]);
+
+    TEST_CHECK(calls >= 40 && received.size() == sent.size());
+    TEST_CHECK(memcmp(received.data(), sent.data(), sent.size() * sizeof(int32_t)) == 0);
+}
+
+TEST_CASE(fdIoReadsExactlyAndRejectsTruncatedStreams)
+{
+    int fds[2] = {-1, -1};
+    TEST_CHECK(pipe(fds) == 0);
+
+    Vector<int64_t> values(100, 5);
+    values[99] = -1;
+
+    writeToFd(fds[1], values);
+    writeBytes(fds[1], "abc", 3);
+    close(fds[1]);
+
+    Vector<int64_t> loaded(100, 0);
+    readExactly(fds[0], VectorView<int64_t>{loaded});
+    TEST_CHECK(loaded[0] == 5 && loaded[99] == -1);
+
+    // 3 bytes left, the element they start never completes
+    Vector<int64_t> tail(1, 7);
+    FdReadResult truncated = appendFromFd(tail, fds[0], 64);
+    TEST_CHECK(truncated.count == 0 && truncated.error == StdErrors::FdIoErr);
+    TEST_CHECK(tail.size() == 1 && tail[0] == 7);
+
+    close(fds[0]);
+
+    // Complete elements read together with a partial one are kept
+    TEST_CHECK(pipe(fds) == 0);
+
+    writeToFd(fds[1], VectorView<const int64_t>{values}.subview(98));
+    writeBytes(fds[1], "abc", 3);
+    close(fds[1]);
+
+    truncated = appendFromFd(tail, fds[0], 64);
+    TEST_CHECK(truncated.count == 2 && truncated.error == StdErrors::FdIoErr);
+    TEST_CHECK(tail.size() == 3 && tail[0] == 7 && tail[1] == 5 && tail[2] == -1);
+
+    FdReadResult end = appendFromFd(tail, fds[0], 64);
+    TEST_CHECK(end.count == 0 && end.error == StdErrors::Ok);
+
+    close(fds[0]);
+}
@@ -0,0 +1,148 @@
+#include "Tests.hpp"
+
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Simd/SimdKernels.hpp"
+
+using namespace MyStd;
+
+namespace
+{
+
+// Calls check once for every level this cpu supports, restores the detected level afterwards
+template<typename Check>
+void forEachSimdLevel(Check check)
+{
+    const SimdLevel detected = detectedSimdLevel();
+
+    for (int level = int(SimdLevel::Scalar); level <= int(detected); ++level)
+    {
+        setSimdLevel(SimdLevel(level));
+        check();
+    }
+
+    setSimdLevel(detected);
+}
+
+} // namespace anon
+
+TEST_CASE(simdIntegerKernelsMatchScalarLoops)
+{
+    // Odd size and offset subviews hit unaligned heads and scalar tails of every kernel
+    const size_t size = 1037;
+
+    Vector<int64_t> values(size, 0);
+    for (size_t i = 0; i < size; ++i)
+        values[i] = int64_t((i * 7919) % 1000) - 500;
+
+    values[611] = -9000;
+    values[900] = 9000;
+
+    forEachSimdLevel([&]()
+    {
+        for (size_t offset = 0; offset < 3; ++offset)
+        {
+            VectorView<const int64_t> view = VectorView<const int64_t>{values}.subview(offset);
+
+            int64_t expectedSum = 0;
+            size_t  expectedCount = 0;
+            for (size_t i = 0; i < view.size(); ++i)
+            {
+                expectedSum += view[i];
+                expectedCount += view[i] == view[5];
+            }
+
+            TEST_CHECK(Simd::sum(view) == expectedSum);
+            TEST_CHECK(Simd::argMin(view) == 611 - offset);
+            TEST_CHECK(Simd::argMax(view) == 900 - offset);
+            TEST_CHECK(Simd::min(view) == -9000 && Simd::max(view) == 9000);
+            TEST_CHECK(Simd::count(view, view[5]) == expectedCount);
+            TEST_CHECK(Simd::find(view, 9000) == 900 - offset);
+            TEST_CHECK(Simd::find(view, 12345) == view.size());
+        }
+    });
+}
+
+TEST_CASE(simdFloatingKernelsMatchScalarLoops)
+{
+    const size_t size = 203;
+
+    Vector<double> lhs(size, 0.0);
+    Vector<double> rhs(size, 0.0);
+    for (size_t i = 0; i < size; ++i)
+    {
+        lhs[i] = double(i % 4);
+        rhs[i] = 0.5;
+    }
+
+    forEachSimdLevel([&]()
+    {
+        // Halves of small integers are exact, so every summation order gives the same result
+        double expectedDot = 0;
+        for (size_t i = 0; i < size; ++i)
+            expectedDot += lhs[i] * rhs[i];
+
+        TEST_CHECK(int64_t(Simd::dot(lhs, rhs) * 2) == int64_t(expectedDot * 2));
+        TEST_CHECK(Simd::count(lhs, 3.0) == size / 4);
+
+        Vector<double> accumulator(size, 1.0);
+        Simd::fma(accumulator, lhs, rhs);
+        Simd::add(accumulator, rhs);
+        Simd::scale(accumulator, 2.0);
+
+        bool allMatch = true;
+        for (size_t i = 0; i < size; ++i)
+            allMatch = allMatch && int64_t(accumulator[i]) == int64_t((1.0 + lhs[i] * 0.5 + 0.5) * 2);
+
+        TEST_CHECK(allMatch);
+    });
+}
+
+TEST_CASE(simdRejectsDifferentSizes)
+{
+    Vector<int32_t> lhs(10, 1);
+    Vector<int32_t> rhs(11, 1);
+
+    TEST_CHECK_THROWS(Simd::dot(lhs, rhs), StdErrors::VectorSizeMismatch);
+    TEST_CHECK_THROWS(Simd::add(lhs, rhs), StdErrors::VectorSizeMismatch);
+}
+
+TEST_CASE(simdUnpackBitsMatchesScalarDecoding)
+{
+    // Every width, with a first value that doesn't start on a word boundary
+    Vector<uint64_t> words(64, 0);
+    for (size_t i = 0; i < words.size(); ++i)
+        words[i] = uint64_t(i + 1) * 0x9E3779B97F4A7C15ull;
+
+    Vector<uint32_t> out(120, 0);
+
+    forEachSimdLevel([&]()
+    {
+        bool same = true;
+        for (unsigned bits = 1; bits <= 32; ++bits)
+        {
+            size_t count = words.size() * 64 / bits - 3;
+            count = count < out.size() ? count : out.size();
+
+            Simd::unpackBits(words.data(), words.size(), bits, 3, count, out.data());
+
+            for (size_t pos = 0; pos < count; ++pos)
+            {
+                size_t bitPos = (pos + 3) * bits;
+
+                uint64_t expected = 0;
+                for (unsigned bit = 0; bit < bits; ++bit)
+                {
+                    size_t at = bitPos + bit;
+                    expected |= ((words[at / 64] >> (at % 64)) & 1) << bit;
+                }
+
+                same = same && out[pos] == expected;
+            }
+        }
+
+        TEST_CHECK(same);
+    });
+}
@@ -0,0 +1,108 @@
+#include "Tests.hpp"
+
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+#include "Parallel/ParallelSort.hpp"
+#include "Parallel/ThreadPool.hpp"
+
+using namespace MyStd;
+
+namespace
+{
+
+// Deterministic scattered values, xorshift
+uint64_t nextRandom(uint64_t& state) noexcept
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+template<typename T, typename Less>
+bool isSorted(const Vector<T>& vector, Less less)
+{
+    for (size_t i = 1; i < vector.size(); ++i)
+    {
+        if (less(vector[i], vector[i - 1]))
+            return false;
+    }
+
+    return true;
+}
+
+struct SortRecord
+{
+    int32_t key;
+    uint32_t order; // position before sorting
+};
+
+} // namespace anon
+
+TEST_CASE(radixSortOrdersIntegersAndFloats)
+{
+    ThreadPool pool{3};
+    uint64_t state = 88172645463325252ull;
+
+    const size_t size = 100000;
+
+    Vector<int64_t> integers(size, 0);
+    Vector<double>  doubles (size, 0.0);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        integers[i] = static_cast<int64_t>(nextRandom(state));
+        doubles [i] = double(integers[i] % 1000) / 8;
+    }
+
+    doubles[0] = -0.0;
+    doubles[1] = 0.0;
+
+    Vector<int64_t> scratch;
+    sort(integers, scratch, pool);
+    sort(integers, scratch, pool);
+
+    sort(doubles, pool);
+
+    TEST_CHECK(isSorted(integers, [](int64_t lhs, int64_t rhs) { return lhs < rhs; }));
+    TEST_CHECK(isSorted(doubles,  [](double  lhs, double  rhs) { return lhs < rhs; }));
+    TEST_CHECK(scratch.size() >= size);
+
+    // Small views take the fallback path
+    VectorView<int64_t> head = VectorView<int64_t>{integers}.subview(0, 100);
+    for (size_t i = 0; i < head.size(); ++i)
+        head[i] = int64_t(100 - i);
+
+    sort(head, pool);
+    TEST_CHECK(head[0] == 1 && head[99] == 100);
+}
+
+TEST_CASE(mergeSortIsStableAcrossChunks)
+{
+    ThreadPool pool{3};
+    uint64_t state = 2463534242ull;
+
+    const size_t size = 60001;
+
+    Vector<SortRecord> records(size, SortRecord{0, 0});
+    for (size_t i = 0; i < size; ++i)
+        records[i] = SortRecord{int32_t(nextRandom(state) % 100), uint32_t(i)};
+
+    Vector<SortRecord> byKey = records;
+
+    stableSort(records, [](const SortRecord& lhs, const SortRecord& rhs) { return lhs.key < rhs.key; }, pool);
+    sortByKey(byKey, [](const SortRecord& record) { return -record.key; }, pool);
+
+    TEST_CHECK(isSorted(records, [](const SortRecord& lhs, const SortRecord& rhs)
+    {
+        return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.order < rhs.order);
+    }));
+
+    TEST_CHECK(isSorted(byKey, [](const SortRecord& lhs, const SortRecord& rhs)
+    {
+        return lhs.key > rhs.key || (lhs.key == rhs.key && lhs.order < rhs.order);
+    }));
+}
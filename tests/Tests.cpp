@@ -0,0 +1,78 @@
+#include "Tests.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace MyStd
+{
+
+namespace Tests
+{
+
+namespace
+{
+
+struct TestCase
+{
+    const char* name;
+    TestFunc func;
+};
+
+std::vector<TestCase>& registeredTests()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+size_t currentFailures = 0;
+
+} // namespace anon
+
+TestRegistrar::TestRegistrar(const char* name, TestFunc func)
+{
+    registeredTests().push_back({name, func});
+}
+
+void checkFailed(const char* expression, const char* file, int line) noexcept
+{
+    fprintf(stderr, "  %s:%d: check failed: %s\n", file, line, expression);
+    ++currentFailures;
+}
+
+size_t runAll()
+{
+    size_t failedTests = 0;
+
+    for (const TestCase& test : registeredTests())
+    {
+        currentFailures = 0;
+
+        try
+        {
+            test.func();
+        }
+        catch (std::exception& exception)
+        {
+            fprintf(stderr, "  unexpected exception: %s\n", exception.what());
+            ++currentFailures;
+        }
+
+        printf("[%s] %s\n", currentFailures ? "FAIL" : " OK ", test.name);
+
+        if (currentFailures)
+            ++failedTests;
+    }
+
+    printf("%zu of %zu tests failed\n", failedTests, registeredTests().size());
+
+    return failedTests;
+}
+
+} // namespace Tests
+
+} // namespace MyStd
+
+int main()
+{
+    return MyStd::Tests::runAll() == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+#ifndef TESTS_TESTS_HPP
+#define TESTS_TESTS_HPP
+
+#include <cstddef>
+
+#include "Errors.hpp"
+#include "Exceptions.hpp"
+
+namespace MyStd
+{
+
+namespace Tests
+{
+
+using TestFunc = void (*)();
+
+// Test cases register themselves during static initialization, runAll() calls them in registration order
+class TestRegistrar final
+{
+public:
+    TestRegistrar(const char* name, TestFunc func);
+};
+
+void checkFailed(const char* expression, const char* file, int line) noexcept;
+
+// Returns number of failed test cases
+size_t runAll();
+
+} // namespace Tests
+
+} // namespace MyStd
+
+#define TEST_CASE(NAME)                                                             \
+    static void NAME();                                                             \
+    static const MyStd::Tests::TestRegistrar NAME##Registrar{#NAME, NAME};          \
+    static void NAME()
+
+#define TEST_CHECK(EXPRESSION)                                                      \
+    do                                                                              \
+    {                                                                               \
+        if (!(EXPRESSION))                                                          \
+            MyStd::Tests::checkFailed(#EXPRESSION, __FILE__, __LINE__);             \
+    } while (0)
+
+// EXPRESSION must throw ExceptionWithReason with ERROR on top of the chain
+#define TEST_CHECK_THROWS(EXPRESSION, ERROR)                                        \
+    do                                                                              \
+    {                                                                               \
+        bool thrown = false;                                                        \
+        try                                                                         \
+        {                                                                           \
+            EXPRESSION;                                                             \
+        }                                                                           \
+        catch (MyStd::ExceptionWithReason& exception)                               \
+        {                                                                           \
+            thrown = exception.error() == (ERROR);                                  \
+        }                                                                           \
+        if (!thrown)                                                                \
+            MyStd::Tests::checkFailed(#EXPRESSION " throws " #ERROR, __FILE__, __LINE__); \
+    } while (0)
+
+#endif // TESTS_TESTS_HPP
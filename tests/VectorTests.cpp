@@ -0,0 +1,121 @@
+#include "Tests.hpp"
+
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "Expected.hpp"
+#include "Allocators/ShrinkingAllocator.hpp"
+#include "Allocators/StaticAllocator.hpp"
+
+using namespace MyStd;
+
+TEST_CASE(vectorTryOperationsReportErrors)
+{
+    Vector<int64_t> vector;
+
+    bool allOk = true;
+    for (int64_t i = 0; i < 1000; ++i)
+        allOk = allOk && vector.tryPushBack(i) == StdErrors::Ok;
+
+    TEST_CHECK(allOk && vector.size() == 1000 && vector[999] == 999);
+
+    TEST_CHECK(vector.tryReserve(static_cast<size_t>(-1) / 2) == StdErrors::MemAllocErr);
+    TEST_CHECK(vector.size() == 1000 && vector[0] == 0);
+
+    TEST_CHECK(vector.tryResize(10) == StdErrors::Ok && vector.size() == 10);
+    TEST_CHECK(vector.tryResize(20, 7) == StdErrors::Ok && vector[19] == 7 && vector[9] == 9);
+
+    Expected<int64_t&> element = vector.tryAt(3);
+    TEST_CHECK(element && element.value() == 3);
+
+    element.value() = 33;
+    TEST_CHECK(vector[3] == 33);
+
+    Expected<int64_t&> missing = vector.tryAt(20);
+    TEST_CHECK(!missing && missing.error() == StdErrors::VectorIndexOutOfBounds);
+}
+
+TEST_CASE(staticVectorTryPushStopsAtCapacity)
+{
+    Vector<int, StaticAllocator<int, 4> > vector;
+
+    for (int i = 0; i < 4; ++i)
+        vector.tryPushBack(i);
+
+    TEST_CHECK(vector.tryPushBack(4) == StdErrors::VectorOnStackNotEnoughMemory);
+    TEST_CHECK(vector.size() == 4 && vector.back() == 3);
+}
+
+TEST_CASE(boolVectorTryOperations)
+{
+    Vector<bool> bits;
+
+    bool allOk = true;
+    for (size_t i = 0; i < 100; ++i)
+        allOk = allOk && bits.tryPushBack(i % 3 == 0) == StdErrors::Ok;
+
+    TEST_CHECK(allOk && bits.size() == 100);
+    TEST_CHECK(bits.tryAt(99).value() && !bits.tryAt(98).value());
+    TEST_CHECK(bits.tryAt(100).error() == StdErrors::VectorIndexOutOfBounds);
+    TEST_CHECK(bits.tryResize(130, true) == StdErrors::Ok && bits.size() == 130 && bits[129] && !bits[98]);
+}
+
+TEST_CASE(shrinkingAllocatorReleasesWithHysteresis)
+{
+    Vector<int64_t, ShrinkingAllocator<int64_t> > vector;
+
+    for (int64_t i = 0; i < 1000; ++i)
+        vector.pushBack(i);
+
+    size_t grownCapacity = vector.capacity();
+
+    // Plain vectors keep everything they ever reserved
+    Vector<int64_t> plain{vector.size(), 1};
+    while (plain.size() > 10)
+        plain.popBack();
+
+    TEST_CHECK(plain.capacity() == 1000);
+
+    while (vector.size() >= grownCapacity / 4)
+        vector.popBack();
+
+    size_t shrunkCapacity = vector.capacity();
+    TEST_CHECK(shrunkCapacity == vector.size() * 2 && vector.back() == int64_t(vector.size()) - 1);
+
+    // Cycling around the size that caused the shrink doesn't reallocate again
+    const int64_t* data = vector.data();
+    for (int round = 0; round < 100; ++round)
+    {
+        vector.pushBack(round);
+        vector.pushBack(round);
+        vector.popBack();
+        vector.popBack();
+    }
+
+    TEST_CHECK(vector.data() == data && vector.capacity() == shrunkCapacity);
+
+    vector.resize(3);
+    TEST_CHECK(vector.capacity() == 16 && vector[2] == 2);
+
+    vector.clear();
+    TEST_CHECK(vector.empty() && vector.capacity() == 16);
+}
+
+TEST_CASE(vectorReportsLiveAndSlackBytes)
+{
+    Vector<int32_t> vector(10, 0);
+    vector.reserve(25);
+
+    VectorMemoryUsage usage = vector.memoryUsage();
+    TEST_CHECK(usage.liveBytes == 10 * sizeof(int32_t) && usage.slackBytes == 15 * sizeof(int32_t));
+
+    // Nothing to release, the buffer stays
+    vector.resize(25);
+    const int32_t* data = vector.data();
+    vector.shrinkToFit();
+    TEST_CHECK(vector.data() == data && vector.memoryUsage().slackBytes == 0);
+
+    Vector<bool> bits(17, true);
+    bits.reserve(64);
+    TEST_CHECK(bits.memoryUsage().liveBytes == 3 && bits.memoryUsage().slackBytes == 5);
+}
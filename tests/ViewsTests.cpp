@@ -0,0 +1,56 @@
+#include "Tests.hpp"
+
+#include <cstdint>
+
+#include "Vector.hpp"
+#include "VectorView.hpp"
+
+using namespace MyStd;
+
+TEST_CASE(vectorViewSlicesWithoutCopying)
+{
+    Vector<int> vector(10, 0);
+    for (size_t i = 0; i < vector.size(); ++i)
+        vector[i] = int(i);
+
+    VectorView<int> middle = VectorView<int>{vector}.subview(2, 5);
+    middle[0] = -2;
+
+    VectorView<const int> readOnly = middle.subview(3);
+
+    TEST_CHECK(vector[2] == -2 && middle.size() == 5 && middle.data() == vector.data() + 2);
+    TEST_CHECK(readOnly.size() == 2 && readOnly.front() == 5 && readOnly.back() == 6);
+    TEST_CHECK(VectorView<int>{vector}.subview(8, 100).size() == 2);
+    TEST_CHECK(VectorView<int>{vector}.subview(10).empty());
+
+    TEST_CHECK_THROWS(middle.at(5), StdErrors::VectorIndexOutOfBounds);
+    TEST_CHECK_THROWS(middle.subview(6), StdErrors::VectorIndexOutOfBounds);
+
+    int sum = 0;
+    for (int value : readOnly)
+        sum += value;
+
+    TEST_CHECK(sum == 11);
+}
+
+TEST_CASE(bitViewStartsAtAnyBit)
+{
+    Vector<bool> bits(40, false);
+
+    BitView view = BitView{bits}.subview(13, 20);
+    view.set(0, true);
+    view.set(19, true);
+
+    TEST_CHECK(view.data() == bits.data() + 1 && view.bitOffset() == 5);
+    TEST_CHECK(bits[13] && bits[32] && !bits[12] && !bits[33]);
+
+    ConstBitView nested = ConstBitView{view}.subview(19);
+    TEST_CHECK(nested.size() == 1 && nested[0] && nested.at(0));
+    TEST_CHECK_THROWS(nested.at(1), StdErrors::VectorIndexOutOfBounds);
+
+    size_t ones = 0;
+    for (bool bit : view)
+        ones += bit;
+
+    TEST_CHECK(ones == 2);
+}